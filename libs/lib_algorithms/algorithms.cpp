@@ -4,6 +4,7 @@
 #include "libs/lib_algorithms/algorithms.h"
 #include "libs/lib_matrix/matrix.h"
 #include "libs/lib_dsu/dsu.h"
+#include "libs/lib_fixed_mvector/fixed_mvector.h"
 
 int find_local_minimum_gradient_descent(const Matrix<int>& matrix) {
     std::random_device rd;
@@ -20,7 +21,7 @@ int find_local_minimum_gradient_descent(const Matrix<int>& matrix) {
     int matrix_rows = matrix.rows();
     int matrix_cols = matrix.cols();
 
-    MVector<MVector<int>> directions = {
+    static constexpr FixedMVector<FixedMVector<int, 2>, 4> directions = {
         {-1, 0},
         {0, -1},
         {1, 0},
@@ -0,0 +1,3 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_concurrent_tvector/concurrent_tvector.h"
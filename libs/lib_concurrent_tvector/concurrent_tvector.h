@@ -0,0 +1,254 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_CONCURRENT_TVECTOR_CONCURRENT_TVECTOR_H_
+#define LIBS_LIB_CONCURRENT_TVECTOR_CONCURRENT_TVECTOR_H_
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "libs/lib_memory_resource/memory_resource.h"
+#include "libs/lib_tvector/tvector.h"
+
+// Append-only vector that many threads can push to at once. A push claims
+// an index with one atomic increment and constructs the element in place.
+// The storage is a table of segments, segment k holding
+// _first_segment << k elements, so elements never move and growing never
+// blocks the other writers: a missing segment is allocated by whichever
+// thread needs it first, the losers of the race free their copy.
+//
+// An element is published once its push returns, at() sees it from any
+// thread from then on, operator[] needs the push to happen before the read
+// (for example through a join). Reads take no locks and do not wait. The
+// resource has to be thread-safe when several threads push.
+template<typename T>
+class ConcurrentTVector {
+ private:
+    struct Cell {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type value;
+        std::atomic<bool> ready;
+    };
+
+    static const size_t _first_bits = 4;
+    static const size_t _first_segment = size_t(1) << _first_bits;
+    static const size_t _max_segments = 64 - _first_bits;
+
+    std::atomic<Cell*> _segments[_max_segments];
+    std::atomic<size_t> _size;
+    MemoryResource* _resource;
+
+ public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    explicit ConcurrentTVector(MemoryResource* resource = nullptr);
+    ConcurrentTVector(const ConcurrentTVector&) = delete;
+    ~ConcurrentTVector() noexcept;
+
+    ConcurrentTVector& operator=(const ConcurrentTVector&) = delete;
+
+    size_type push_back(const value_type& value);
+    size_type push_back(value_type&& value);
+    template<class... Args>
+    size_type emplace_back(Args&&... args);
+    void reserve(size_type);
+
+    inline size_type size() const noexcept;
+    inline bool is_published(size_type index) const noexcept;
+    inline reference operator[](size_type index) noexcept;
+    inline const_reference operator[](size_type index) const noexcept;
+    reference at(size_type index);
+    const_reference at(size_type index) const;
+    inline MemoryResource* resource() const noexcept;
+
+ private:
+    static inline size_type segment_of(size_type index) noexcept;
+    static inline size_type segment_size(size_type segment) noexcept;
+    static inline size_type segment_start(size_type segment) noexcept;
+    inline Cell& cell(size_type index) const noexcept;
+    Cell* get_segment(size_type segment);
+};
+
+template<typename T>
+ConcurrentTVector<T>::ConcurrentTVector(MemoryResource* resource) :
+    _size(0), _resource(resource ? resource : get_default_resource()) {
+    for (size_type i = 0; i < _max_segments; i++) {
+        _segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+ConcurrentTVector<T>::~ConcurrentTVector() noexcept {
+    for (size_type k = 0; k < _max_segments; k++) {
+        Cell* segment = _segments[k].load(std::memory_order_acquire);
+
+        if (segment == nullptr)
+            continue;
+
+        for (size_type i = 0; i < segment_size(k); i++) {
+            if (segment[i].ready.load(std::memory_order_relaxed))
+                reinterpret_cast<T*>(&segment[i].value)->~T();
+        }
+
+        _resource->deallocate(segment, segment_size(k) * sizeof(Cell),
+            alignof(Cell));
+    }
+}
+
+template<typename T>
+typename ConcurrentTVector<T>::size_type
+ConcurrentTVector<T>::push_back(const value_type& value) {
+    return emplace_back(value);
+}
+
+template<typename T>
+typename ConcurrentTVector<T>::size_type
+ConcurrentTVector<T>::push_back(value_type&& value) {
+    return emplace_back(std::move(value));
+}
+
+// Returns the index of the new element. If the constructor throws, the
+// index stays claimed and is never published.
+template<typename T>
+template<class... Args>
+typename ConcurrentTVector<T>::size_type
+ConcurrentTVector<T>::emplace_back(Args&&... args) {
+    size_type index = _size.fetch_add(1, std::memory_order_relaxed);
+    size_type segment = segment_of(index);
+    Cell& target = get_segment(segment)[index - segment_start(segment)];
+
+    ::new (static_cast<void*>(&target.value)) T(std::forward<Args>(args)...);
+    target.ready.store(true, std::memory_order_release);
+
+    return index;
+}
+
+// Allocates the segments for the first count elements ahead of time, so the
+// writers do not race for them. Safe to call while others push.
+template<typename T>
+void ConcurrentTVector<T>::reserve(size_type count) {
+    if (count == 0)
+        return;
+
+    for (size_type k = 0; k <= segment_of(count - 1); k++) {
+        get_segment(k);
+    }
+}
+
+// Claimed indices, the ones being constructed right now included.
+template<typename T>
+inline typename ConcurrentTVector<T>::size_type ConcurrentTVector<T>::size()
+const noexcept {
+    return _size.load(std::memory_order_acquire);
+}
+
+template<typename T>
+inline bool ConcurrentTVector<T>::is_published(size_type index)
+const noexcept {
+    if (index >= size())
+        return false;
+
+    size_type segment = segment_of(index);
+    Cell* cells = _segments[segment].load(std::memory_order_acquire);
+
+    return cells != nullptr &&
+        cells[index - segment_start(segment)].ready.load(
+            std::memory_order_acquire);
+}
+
+template<typename T>
+inline typename ConcurrentTVector<T>::reference
+ConcurrentTVector<T>::operator[](size_type index) noexcept {
+    return *reinterpret_cast<T*>(&cell(index).value);
+}
+
+template<typename T>
+inline typename ConcurrentTVector<T>::const_reference
+ConcurrentTVector<T>::operator[](size_type index) const noexcept {
+    return *reinterpret_cast<const T*>(&cell(index).value);
+}
+
+template<typename T>
+typename ConcurrentTVector<T>::reference
+ConcurrentTVector<T>::at(size_type index) {
+    if (!is_published(index)) {
+        throw std::out_of_range("ConcurrentTVector at: Element is not "
+            "published.");
+    }
+
+    return (*this)[index];
+}
+
+template<typename T>
+typename ConcurrentTVector<T>::const_reference
+ConcurrentTVector<T>::at(size_type index) const {
+    if (!is_published(index)) {
+        throw std::out_of_range("ConcurrentTVector at: Element is not "
+            "published.");
+    }
+
+    return (*this)[index];
+}
+
+template<typename T>
+inline MemoryResource* ConcurrentTVector<T>::resource() const noexcept {
+    return _resource;
+}
+
+template<typename T>
+inline typename ConcurrentTVector<T>::size_type
+ConcurrentTVector<T>::segment_of(size_type index) noexcept {
+    return tvector_detail::highest_bit(index + _first_segment) - _first_bits;
+}
+
+template<typename T>
+inline typename ConcurrentTVector<T>::size_type
+ConcurrentTVector<T>::segment_size(size_type segment) noexcept {
+    return _first_segment << segment;
+}
+
+template<typename T>
+inline typename ConcurrentTVector<T>::size_type
+ConcurrentTVector<T>::segment_start(size_type segment) noexcept {
+    return segment_size(segment) - _first_segment;
+}
+
+template<typename T>
+inline typename ConcurrentTVector<T>::Cell&
+ConcurrentTVector<T>::cell(size_type index) const noexcept {
+    size_type segment = segment_of(index);
+    Cell* cells = _segments[segment].load(std::memory_order_acquire);
+
+    return cells[index - segment_start(segment)];
+}
+
+template<typename T>
+typename ConcurrentTVector<T>::Cell*
+ConcurrentTVector<T>::get_segment(size_type segment) {
+    Cell* cells = _segments[segment].load(std::memory_order_acquire);
+
+    if (cells != nullptr)
+        return cells;
+
+    size_type count = segment_size(segment);
+    Cell* created = static_cast<Cell*>(_resource->allocate(
+        count * sizeof(Cell), alignof(Cell)));
+
+    for (size_type i = 0; i < count; i++) {
+        ::new (static_cast<void*>(&created[i].ready)) std::atomic<bool>(false);
+    }
+
+    if (_segments[segment].compare_exchange_strong(cells, created,
+        std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return created;
+    }
+
+    _resource->deallocate(created, count * sizeof(Cell), alignof(Cell));
+
+    return cells;
+}
+
+#endif  // LIBS_LIB_CONCURRENT_TVECTOR_CONCURRENT_TVECTOR_H_
@@ -0,0 +1,3 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_copy_on_write/copy_on_write.h"
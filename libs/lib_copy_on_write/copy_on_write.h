@@ -0,0 +1,202 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_COPY_ON_WRITE_COPY_ON_WRITE_H_
+#define LIBS_LIB_COPY_ON_WRITE_COPY_ON_WRITE_H_
+
+#include <atomic>
+#include <new>
+#include <utility>
+#include "libs/lib_memory_resource/memory_resource.h"
+
+// Value of type T behind a reference counted block. Copies share the block
+// and cost O(1) whatever T is, write() gives the caller its own copy first
+// if the block is shared. Meant for TVector, MVector and Matrix values that
+// are passed around by value and mostly read:
+//
+//     CopyOnWrite<Matrix<double>> stage = input;  // no deep copy
+//     stage.write()[0][0] = 1.0;                  // copies here, once
+//
+// The count is atomic, so copies may live in different threads; a single
+// CopyOnWrite object is not synchronized. A moved-from object may only be
+// destroyed or assigned.
+template<typename T>
+class CopyOnWrite {
+ private:
+    struct Block {
+        std::atomic<size_t> owners;
+        T value;
+
+        template<class... Args>
+        explicit Block(Args&&... args) : owners(1),
+            value(std::forward<Args>(args)...) {}
+    };
+
+    Block* _block;
+    MemoryResource* _resource;
+
+ public:
+    CopyOnWrite();
+    explicit CopyOnWrite(const T& value, MemoryResource* resource = nullptr);
+    explicit CopyOnWrite(T&& value, MemoryResource* resource = nullptr);
+    CopyOnWrite(const CopyOnWrite& other) noexcept;
+    CopyOnWrite(CopyOnWrite&& other) noexcept;
+    ~CopyOnWrite() noexcept;
+
+    CopyOnWrite& operator=(const CopyOnWrite& other) noexcept;
+    CopyOnWrite& operator=(CopyOnWrite&& other) noexcept;
+
+    inline const T& read() const noexcept;
+    inline const T& operator*() const noexcept;
+    inline const T* operator->() const noexcept;
+    T& write();
+
+    inline bool is_shared() const noexcept;
+    inline size_t use_count() const noexcept;
+    inline MemoryResource* resource() const noexcept;
+
+ private:
+    template<class... Args>
+    static Block* create(MemoryResource* resource, Args&&... args);
+    void release() noexcept;
+};
+
+template<typename T>
+CopyOnWrite<T>::CopyOnWrite() : _block(nullptr),
+    _resource(get_default_resource()) {
+    _block = create(_resource);
+}
+
+template<typename T>
+CopyOnWrite<T>::CopyOnWrite(const T& value, MemoryResource* resource) :
+    _block(nullptr), _resource(resource ? resource : get_default_resource()) {
+    _block = create(_resource, value);
+}
+
+template<typename T>
+CopyOnWrite<T>::CopyOnWrite(T&& value, MemoryResource* resource) :
+    _block(nullptr), _resource(resource ? resource : get_default_resource()) {
+    _block = create(_resource, std::move(value));
+}
+
+template<typename T>
+CopyOnWrite<T>::CopyOnWrite(const CopyOnWrite& other) noexcept :
+    _block(other._block), _resource(other._resource) {
+    if (_block != nullptr)
+        _block->owners.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename T>
+CopyOnWrite<T>::CopyOnWrite(CopyOnWrite&& other) noexcept :
+    _block(other._block), _resource(other._resource) {
+    other._block = nullptr;
+}
+
+template<typename T>
+CopyOnWrite<T>::~CopyOnWrite() noexcept {
+    release();
+}
+
+template<typename T>
+CopyOnWrite<T>& CopyOnWrite<T>::operator=(const CopyOnWrite& other) noexcept {
+    if (_block == other._block)
+        return *this;
+
+    if (other._block != nullptr)
+        other._block->owners.fetch_add(1, std::memory_order_relaxed);
+
+    release();
+    _block = other._block;
+    _resource = other._resource;
+
+    return *this;
+}
+
+template<typename T>
+CopyOnWrite<T>& CopyOnWrite<T>::operator=(CopyOnWrite&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    release();
+    _block = other._block;
+    _resource = other._resource;
+    other._block = nullptr;
+
+    return *this;
+}
+
+template<typename T>
+inline const T& CopyOnWrite<T>::read() const noexcept {
+    return _block->value;
+}
+
+template<typename T>
+inline const T& CopyOnWrite<T>::operator*() const noexcept {
+    return _block->value;
+}
+
+template<typename T>
+inline const T* CopyOnWrite<T>::operator->() const noexcept {
+    return &_block->value;
+}
+
+// Do not keep the reference across copies of this object: a copy shares
+// the block and would see the later writes.
+template<typename T>
+T& CopyOnWrite<T>::write() {
+    if (is_shared()) {
+        Block* copy = create(_resource, _block->value);
+
+        release();
+        _block = copy;
+    }
+
+    return _block->value;
+}
+
+template<typename T>
+inline bool CopyOnWrite<T>::is_shared() const noexcept {
+    return use_count() > 1;
+}
+
+template<typename T>
+inline size_t CopyOnWrite<T>::use_count() const noexcept {
+    if (_block == nullptr)
+        return 0;
+
+    return _block->owners.load(std::memory_order_acquire);
+}
+
+template<typename T>
+inline MemoryResource* CopyOnWrite<T>::resource() const noexcept {
+    return _resource;
+}
+
+template<typename T>
+template<class... Args>
+typename CopyOnWrite<T>::Block* CopyOnWrite<T>::create(
+    MemoryResource* resource, Args&&... args) {
+    void* memory = resource->allocate(sizeof(Block), alignof(Block));
+
+    try {
+        ScopedDefaultResource scope(resource);
+        return ::new (memory) Block(std::forward<Args>(args)...);
+    } catch (...) {
+        resource->deallocate(memory, sizeof(Block), alignof(Block));
+        throw;
+    }
+}
+
+template<typename T>
+void CopyOnWrite<T>::release() noexcept {
+    if (_block == nullptr)
+        return;
+
+    if (_block->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        _block->~Block();
+        _resource->deallocate(_block, sizeof(Block), alignof(Block));
+    }
+
+    _block = nullptr;
+}
+
+#endif  // LIBS_LIB_COPY_ON_WRITE_COPY_ON_WRITE_H_
@@ -0,0 +1,301 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_FIXED_MATRIX_FIXED_MATRIX_H_
+#define LIBS_LIB_FIXED_MATRIX_FIXED_MATRIX_H_
+
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "libs/lib_fixed_mvector/fixed_mvector.h"
+#include "libs/lib_matrix/matrix.h"
+#include "libs/lib_mvector/mvector.h"
+
+// Matrix of R x C elements stored inside the object, for 3x3 and 4x4
+// transforms and the like. Everything but the conversions to and from the
+// dynamic Matrix is constexpr, and the products are expanded at compile
+// time into one sum per result element:
+//
+//     constexpr FixedMatrix<int, 2, 2> swap = { { 0, 1 }, { 1, 0 } };
+//     constexpr FixedMVector<int, 2> p = swap * FixedMVector<int, 2>{ 3, 4 };
+template<typename T, size_t R, size_t C>
+class FixedMatrix {
+ private:
+    FixedMVector<T, C> _data[R];
+
+ public:
+    using value_type = T;
+
+    constexpr FixedMatrix();
+    constexpr FixedMatrix(
+        std::initializer_list<std::initializer_list<T>> init);
+    explicit FixedMatrix(const Matrix<T>&);
+
+    operator Matrix<T>() const;
+
+    static constexpr size_t rows() noexcept;
+    static constexpr size_t cols() noexcept;
+    static constexpr FixedMatrix<T, R, C> identity();
+
+    constexpr FixedMVector<T, C>& operator[](size_t index) noexcept;
+    constexpr const FixedMVector<T, C>& operator[](size_t index)
+        const noexcept;
+
+    constexpr FixedMatrix<T, R, C> operator+(const FixedMatrix<T, R, C>&)
+        const;
+    constexpr FixedMatrix<T, R, C> operator-(const FixedMatrix<T, R, C>&)
+        const;
+    template<size_t K>
+    constexpr FixedMatrix<T, R, K> operator*(const FixedMatrix<T, C, K>&)
+        const;
+    constexpr FixedMVector<T, R> operator*(const FixedMVector<T, C>&) const;
+
+    constexpr FixedMatrix<T, R, C>& operator+=(const FixedMatrix<T, R, C>&);
+    constexpr FixedMatrix<T, R, C>& operator-=(const FixedMatrix<T, R, C>&);
+
+    constexpr FixedMatrix<T, R, C> operator*(const T&) const;
+    constexpr FixedMatrix<T, R, C> operator/(const T&) const;
+    constexpr FixedMatrix<T, R, C>& operator*=(const T&);
+    constexpr FixedMatrix<T, R, C>& operator/=(const T&);
+
+    constexpr bool operator==(const FixedMatrix<T, R, C>& other) const;
+    constexpr bool operator!=(const FixedMatrix<T, R, C>& other) const;
+
+    constexpr FixedMatrix<T, C, R> transpose() const;
+
+ private:
+    template<size_t K, size_t... I>
+    constexpr T product(const FixedMatrix<T, C, K>&, size_t, size_t,
+        std::index_sequence<I...>) const;
+    template<size_t... I>
+    constexpr T product(const FixedMVector<T, C>&, size_t,
+        std::index_sequence<I...>) const;
+};
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>::FixedMatrix() : _data{} {}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>::FixedMatrix(
+    std::initializer_list<std::initializer_list<T>> init) : _data{} {
+    if (init.size() != R) {
+        throw std::invalid_argument("FixedMatrix: Wrong number of rows");
+    }
+
+    size_t i = 0;
+
+    for (const auto& row : init) {
+        if (row.size() != C) {
+            throw std::invalid_argument("FixedMatrix: All rows"
+                                        " must have the same length");
+        }
+
+        _data[i++] = FixedMVector<T, C>(row);
+    }
+}
+
+template<typename T, size_t R, size_t C>
+FixedMatrix<T, R, C>::FixedMatrix(const Matrix<T>& other) : _data{} {
+    if (other.rows() != R || other.cols() != C) {
+        throw std::invalid_argument("FixedMatrix: Incompatible sizes");
+    }
+
+    for (size_t i = 0; i < R; i++) {
+        for (size_t j = 0; j < C; j++) {
+            _data[i][j] = other.data()[i * other.stride() + j];
+        }
+    }
+}
+
+template<typename T, size_t R, size_t C>
+FixedMatrix<T, R, C>::operator Matrix<T>() const {
+    Matrix<T> result(R, C);
+
+    for (size_t i = 0; i < R; i++) {
+        for (size_t j = 0; j < C; j++) {
+            result.data()[i * result.stride() + j] = _data[i][j];
+        }
+    }
+
+    return result;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr size_t FixedMatrix<T, R, C>::rows() noexcept {
+    return R;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr size_t FixedMatrix<T, R, C>::cols() noexcept {
+    return C;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::identity() {
+    static_assert(R == C, "FixedMatrix: identity must be square");
+
+    FixedMatrix<T, R, C> result;
+
+    for (size_t i = 0; i < R; i++) {
+        result._data[i][i] = T(1);
+    }
+
+    return result;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMVector<T, C>& FixedMatrix<T, R, C>::operator[](size_t index)
+noexcept {
+    return _data[index];
+}
+
+template<typename T, size_t R, size_t C>
+constexpr const FixedMVector<T, C>& FixedMatrix<T, R, C>::operator[](
+    size_t index) const noexcept {
+    return _data[index];
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator+(
+    const FixedMatrix<T, R, C>& other) const {
+    FixedMatrix<T, R, C> result(*this);
+
+    return result += other;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator-(
+    const FixedMatrix<T, R, C>& other) const {
+    FixedMatrix<T, R, C> result(*this);
+
+    return result -= other;
+}
+
+template<typename T, size_t R, size_t C>
+template<size_t K>
+constexpr FixedMatrix<T, R, K> FixedMatrix<T, R, C>::operator*(
+    const FixedMatrix<T, C, K>& other) const {
+    FixedMatrix<T, R, K> result;
+
+    for (size_t i = 0; i < R; i++) {
+        for (size_t j = 0; j < K; j++) {
+            result[i][j] = product(other, i, j, std::make_index_sequence<C>());
+        }
+    }
+
+    return result;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMVector<T, R> FixedMatrix<T, R, C>::operator*(
+    const FixedMVector<T, C>& column) const {
+    FixedMVector<T, R> result;
+
+    for (size_t i = 0; i < R; i++) {
+        result[i] = product(column, i, std::make_index_sequence<C>());
+    }
+
+    return result;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator+=(
+    const FixedMatrix<T, R, C>& other) {
+    for (size_t i = 0; i < R; i++) {
+        _data[i] += other._data[i];
+    }
+
+    return *this;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator-=(
+    const FixedMatrix<T, R, C>& other) {
+    for (size_t i = 0; i < R; i++) {
+        _data[i] -= other._data[i];
+    }
+
+    return *this;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator*(
+    const T& scalar) const {
+    FixedMatrix<T, R, C> result(*this);
+
+    return result *= scalar;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator/(
+    const T& scalar) const {
+    FixedMatrix<T, R, C> result(*this);
+
+    return result /= scalar;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator*=(
+    const T& scalar) {
+    for (size_t i = 0; i < R; i++) {
+        _data[i] *= scalar;
+    }
+
+    return *this;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator/=(
+    const T& scalar) {
+    for (size_t i = 0; i < R; i++) {
+        _data[i] /= scalar;
+    }
+
+    return *this;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr bool FixedMatrix<T, R, C>::operator==(
+    const FixedMatrix<T, R, C>& other) const {
+    for (size_t i = 0; i < R; i++) {
+        if (_data[i] != other._data[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename T, size_t R, size_t C>
+constexpr bool FixedMatrix<T, R, C>::operator!=(
+    const FixedMatrix<T, R, C>& other) const {
+    return !(*this == other);
+}
+
+template<typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, C, R> FixedMatrix<T, R, C>::transpose() const {
+    FixedMatrix<T, C, R> result;
+
+    for (size_t i = 0; i < R; i++) {
+        for (size_t j = 0; j < C; j++) {
+            result[j][i] = _data[i][j];
+        }
+    }
+
+    return result;
+}
+
+template<typename T, size_t R, size_t C>
+template<size_t K, size_t... I>
+constexpr T FixedMatrix<T, R, C>::product(const FixedMatrix<T, C, K>& other,
+    size_t row, size_t col, std::index_sequence<I...>) const {
+    return fixed_detail::sum<T>((_data[row][I] * other[I][col])...);
+}
+
+template<typename T, size_t R, size_t C>
+template<size_t... I>
+constexpr T FixedMatrix<T, R, C>::product(const FixedMVector<T, C>& column,
+    size_t row, std::index_sequence<I...>) const {
+    return fixed_detail::sum<T>((_data[row][I] * column[I])...);
+}
+
+#endif  // LIBS_LIB_FIXED_MATRIX_FIXED_MATRIX_H_
@@ -0,0 +1,3 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_fixed_mvector/fixed_mvector.h"
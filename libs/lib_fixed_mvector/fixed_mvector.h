@@ -0,0 +1,265 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_FIXED_MVECTOR_FIXED_MVECTOR_H_
+#define LIBS_LIB_FIXED_MVECTOR_FIXED_MVECTOR_H_
+
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "libs/lib_mvector/mvector.h"
+
+namespace fixed_detail {
+
+template<typename T>
+constexpr T sum(T value) {
+    return value;
+}
+
+// Adds the terms in one expression, so a pack expansion over an
+// index_sequence gives a product without a loop.
+template<typename T, typename... Rest>
+constexpr T sum(T first, Rest... rest) {
+    return first + sum<T>(rest...);
+}
+
+}  // namespace fixed_detail
+
+// MVector of exactly N elements kept inside the object: no allocation,
+// usable in constant expressions, and the loops have bounds known at
+// compile time. operator[] does not check the index. Converts to and from
+// MVector when a dynamic vector is needed:
+//
+//     constexpr FixedMVector<int, 2> offset = { 1, -1 };
+//     MVector<int> dynamic = offset;
+template<typename T, size_t N>
+class FixedMVector {
+    static_assert(N > 0, "FixedMVector: size must be positive");
+
+ private:
+    T _data[N];
+
+ public:
+    using value_type = T;
+
+    constexpr FixedMVector();
+    constexpr FixedMVector(std::initializer_list<T> init);
+    explicit FixedMVector(const MVector<T>&);
+
+    operator MVector<T>() const;
+
+    constexpr FixedMVector<T, N> operator+(const FixedMVector<T, N>&) const;
+    constexpr FixedMVector<T, N> operator-(const FixedMVector<T, N>&) const;
+    constexpr T operator*(const FixedMVector<T, N>&) const;
+    constexpr FixedMVector<T, N> operator*(T scalar) const;
+    constexpr FixedMVector<T, N> operator/(T scalar) const;
+    constexpr T& operator[](size_t index) noexcept;
+    constexpr const T& operator[](size_t index) const noexcept;
+
+    constexpr FixedMVector<T, N>& operator+=(const FixedMVector<T, N>&);
+    constexpr FixedMVector<T, N>& operator-=(const FixedMVector<T, N>&);
+    constexpr FixedMVector<T, N>& operator*=(T scalar);
+    constexpr FixedMVector<T, N>& operator/=(T scalar);
+
+    constexpr bool operator==(const FixedMVector<T, N>& other) const;
+    constexpr bool operator!=(const FixedMVector<T, N>& other) const;
+
+    T length() const;
+    FixedMVector<T, N> normalized() const;
+
+    static constexpr size_t size() noexcept;
+    constexpr T* data() noexcept;
+    constexpr const T* data() const noexcept;
+
+ private:
+    template<size_t... I>
+    constexpr T dot(const FixedMVector<T, N>&, std::index_sequence<I...>)
+        const;
+};
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N>::FixedMVector() : _data{} {}
+
+// Elements past the end of init are value-initialized.
+template<typename T, size_t N>
+constexpr FixedMVector<T, N>::FixedMVector(std::initializer_list<T> init) :
+    _data{} {
+    if (init.size() > N) {
+        throw std::invalid_argument("FixedMVector: too many elements");
+    }
+
+    size_t i = 0;
+
+    for (const T& value : init) {
+        _data[i++] = value;
+    }
+}
+
+template<typename T, size_t N>
+FixedMVector<T, N>::FixedMVector(const MVector<T>& other) : _data{} {
+    if (other.size() != N) {
+        throw std::invalid_argument("FixedMVector: size mismatch");
+    }
+
+    for (size_t i = 0; i < N; i++) {
+        _data[i] = other.data()[i];
+    }
+}
+
+template<typename T, size_t N>
+FixedMVector<T, N>::operator MVector<T>() const {
+    MVector<T> result(static_cast<int>(N));
+
+    for (size_t i = 0; i < N; i++) {
+        result.data()[i] = _data[i];
+    }
+
+    return result;
+}
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N> FixedMVector<T, N>::operator+(
+    const FixedMVector<T, N>& other) const {
+    FixedMVector<T, N> result(*this);
+
+    return result += other;
+}
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N> FixedMVector<T, N>::operator-(
+    const FixedMVector<T, N>& other) const {
+    FixedMVector<T, N> result(*this);
+
+    return result -= other;
+}
+
+template<typename T, size_t N>
+constexpr T FixedMVector<T, N>::operator*(const FixedMVector<T, N>& other)
+const {
+    return dot(other, std::make_index_sequence<N>());
+}
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N> FixedMVector<T, N>::operator*(T scalar) const {
+    FixedMVector<T, N> result(*this);
+
+    return result *= scalar;
+}
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N> FixedMVector<T, N>::operator/(T scalar) const {
+    FixedMVector<T, N> result(*this);
+
+    return result /= scalar;
+}
+
+template<typename T, size_t N>
+constexpr T& FixedMVector<T, N>::operator[](size_t index) noexcept {
+    return _data[index];
+}
+
+template<typename T, size_t N>
+constexpr const T& FixedMVector<T, N>::operator[](size_t index)
+const noexcept {
+    return _data[index];
+}
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N>& FixedMVector<T, N>::operator+=(
+    const FixedMVector<T, N>& other) {
+    for (size_t i = 0; i < N; i++) {
+        _data[i] = _data[i] + other._data[i];
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N>& FixedMVector<T, N>::operator-=(
+    const FixedMVector<T, N>& other) {
+    for (size_t i = 0; i < N; i++) {
+        _data[i] = _data[i] - other._data[i];
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N>& FixedMVector<T, N>::operator*=(T scalar) {
+    for (size_t i = 0; i < N; i++) {
+        _data[i] = _data[i] * scalar;
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+constexpr FixedMVector<T, N>& FixedMVector<T, N>::operator/=(T scalar) {
+    if (scalar == T()) {
+        throw std::invalid_argument("FixedMVector: divide by zero");
+    }
+
+    for (size_t i = 0; i < N; i++) {
+        _data[i] = _data[i] / scalar;
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+constexpr bool FixedMVector<T, N>::operator==(
+    const FixedMVector<T, N>& other) const {
+    for (size_t i = 0; i < N; i++) {
+        if (_data[i] != other._data[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename T, size_t N>
+constexpr bool FixedMVector<T, N>::operator!=(
+    const FixedMVector<T, N>& other) const {
+    return !(*this == other);
+}
+
+template<typename T, size_t N>
+T FixedMVector<T, N>::length() const {
+    return sqrt(*this * *this);
+}
+
+template<typename T, size_t N>
+FixedMVector<T, N> FixedMVector<T, N>::normalized() const {
+    T len = length();
+
+    if (len == 0) {
+        throw std::domain_error("Cannot normalize zero vector");
+    }
+
+    return *this / len;
+}
+
+template<typename T, size_t N>
+constexpr size_t FixedMVector<T, N>::size() noexcept {
+    return N;
+}
+
+template<typename T, size_t N>
+constexpr T* FixedMVector<T, N>::data() noexcept {
+    return _data;
+}
+
+template<typename T, size_t N>
+constexpr const T* FixedMVector<T, N>::data() const noexcept {
+    return _data;
+}
+
+template<typename T, size_t N>
+template<size_t... I>
+constexpr T FixedMVector<T, N>::dot(const FixedMVector<T, N>& other,
+    std::index_sequence<I...>) const {
+    return fixed_detail::sum<T>((_data[I] * other._data[I])...);
+}
+
+#endif  // LIBS_LIB_FIXED_MVECTOR_FIXED_MVECTOR_H_
@@ -0,0 +1,233 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_mapped_tvector/mapped_tvector.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+MappedFile::MappedFile(const std::string& path) : _file(nullptr),
+    _mapping(nullptr), _data(nullptr), _size(0) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("MappedFile: cannot open " + path);
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error("MappedFile: cannot stat " + path);
+    }
+
+    _file = file;
+    _size = static_cast<size_t>(size.QuadPart);
+
+    try {
+        map();
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+#else
+MappedFile::MappedFile(const std::string& path) : _file(-1), _data(nullptr),
+    _size(0) {
+    int file = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+    if (file < 0)
+        throw std::runtime_error("MappedFile: cannot open " + path);
+
+    struct stat info;
+
+    if (fstat(file, &info) != 0) {
+        ::close(file);
+        throw std::runtime_error("MappedFile: cannot stat " + path);
+    }
+
+    _file = file;
+    _size = static_cast<size_t>(info.st_size);
+
+    try {
+        map();
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : _file(other._file),
+#if defined(_WIN32)
+    _mapping(other._mapping),
+#endif
+    _data(other._data), _size(other._size) {
+#if defined(_WIN32)
+    other._file = nullptr;
+    other._mapping = nullptr;
+#else
+    other._file = -1;
+#endif
+    other._data = nullptr;
+    other._size = 0;
+}
+
+MappedFile::~MappedFile() noexcept {
+    close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this == &other)
+        return *this;
+
+    close();
+    std::swap(_file, other._file);
+#if defined(_WIN32)
+    std::swap(_mapping, other._mapping);
+#endif
+    std::swap(_data, other._data);
+    std::swap(_size, other._size);
+
+    return *this;
+}
+
+#if defined(_WIN32)
+void MappedFile::resize(size_t bytes) {
+    unmap();
+
+    LARGE_INTEGER size;
+    size.QuadPart = static_cast<LONGLONG>(bytes);
+
+    if (!SetFilePointerEx(_file, size, nullptr, FILE_BEGIN) ||
+        !SetEndOfFile(_file)) {
+        map();
+        throw std::runtime_error("MappedFile: cannot resize the file");
+    }
+
+    _size = bytes;
+    map();
+}
+
+void MappedFile::flush() {
+    if (_data != nullptr && !FlushViewOfFile(_data, 0))
+        throw std::runtime_error("MappedFile: cannot flush the mapping");
+
+    if (!FlushFileBuffers(_file))
+        throw std::runtime_error("MappedFile: cannot flush the file");
+}
+
+void MappedFile::map() {
+    if (_size == 0)
+        return;
+
+    ULARGE_INTEGER size;
+    size.QuadPart = _size;
+
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READWRITE,
+        size.HighPart, size.LowPart, nullptr);
+
+    if (_mapping == nullptr)
+        throw std::runtime_error("MappedFile: cannot map the file");
+
+    _data = MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, _size);
+
+    if (_data == nullptr) {
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+        throw std::runtime_error("MappedFile: cannot map the file");
+    }
+}
+
+void MappedFile::unmap() noexcept {
+    if (_data != nullptr)
+        UnmapViewOfFile(_data);
+
+    if (_mapping != nullptr)
+        CloseHandle(_mapping);
+
+    _data = nullptr;
+    _mapping = nullptr;
+}
+
+void MappedFile::close() noexcept {
+    unmap();
+
+    if (_file != nullptr)
+        CloseHandle(_file);
+
+    _file = nullptr;
+    _size = 0;
+}
+#else
+void MappedFile::resize(size_t bytes) {
+    if (ftruncate(_file, static_cast<off_t>(bytes)) != 0)
+        throw std::runtime_error("MappedFile: cannot resize the file");
+
+#if defined(__linux__)
+    // The kernel can move the pages of the view without copying them.
+    if (_data != nullptr && bytes > 0) {
+        void* data = mremap(_data, _size, bytes, MREMAP_MAYMOVE);
+
+        if (data == MAP_FAILED)
+            throw std::runtime_error("MappedFile: cannot map the file");
+
+        _data = data;
+        _size = bytes;
+        return;
+    }
+#endif
+
+    unmap();
+    _size = bytes;
+    map();
+}
+
+void MappedFile::flush() {
+    if (_data != nullptr && msync(_data, _size, MS_SYNC) != 0)
+        throw std::runtime_error("MappedFile: cannot flush the mapping");
+}
+
+void MappedFile::map() {
+    if (_size == 0)
+        return;
+
+    void* data = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED,
+        _file, 0);
+
+    if (data == MAP_FAILED)
+        throw std::runtime_error("MappedFile: cannot map the file");
+
+    _data = data;
+}
+
+void MappedFile::unmap() noexcept {
+    if (_data != nullptr)
+        munmap(_data, _size);
+
+    _data = nullptr;
+}
+
+void MappedFile::close() noexcept {
+    unmap();
+
+    if (_file >= 0)
+        ::close(_file);
+
+    _file = -1;
+    _size = 0;
+}
+#endif
@@ -0,0 +1,355 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_MAPPED_TVECTOR_MAPPED_TVECTOR_H_
+#define LIBS_LIB_MAPPED_TVECTOR_MAPPED_TVECTOR_H_
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Read-write shared mapping of a whole file. The file is created if it does
+// not exist, resize() changes its length and maps it again, so pointers into
+// the old view are invalidated.
+class MappedFile {
+ private:
+#if defined(_WIN32)
+    void* _file;
+    void* _mapping;
+#else
+    int _file;
+#endif
+    void* _data;
+    size_t _size;
+
+ public:
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) noexcept;
+    ~MappedFile() noexcept;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) noexcept;
+
+    inline void* data() const noexcept { return _data; }
+    inline size_t size() const noexcept { return _size; }
+
+    void resize(size_t bytes);
+    void flush();
+
+ private:
+    void map();
+    void unmap() noexcept;
+    void close() noexcept;
+};
+
+// Vector of trivially copyable elements stored in a file. The elements are
+// kept in the file as they are in memory behind a small header, so opening
+// an existing file maps it and does not read anything; the OS pages the
+// data in on demand. Changes reach the file through the page cache, flush()
+// waits until they are on disk.
+template<typename T>
+class MappedTVector {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "MappedTVector: T must be trivially copyable");
+
+ private:
+    struct Header {
+        uint64_t magic;
+        uint64_t element_size;
+        uint64_t size;
+    };
+
+    static const uint64_t _magic = 0x31565456444d5341ULL;
+    static const size_t _data_offset = 64;
+    static const size_t _capacity_step = 15;
+
+    static_assert(sizeof(Header) <= _data_offset &&
+        alignof(T) <= _data_offset,
+        "MappedTVector: element alignment is too large");
+
+    MappedFile _file;
+
+ public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    explicit MappedTVector(const std::string& path);
+    MappedTVector(const MappedTVector&) = delete;
+    // A moved-from vector is empty, it may only be read, cleared, destroyed
+    // or assigned.
+    MappedTVector(MappedTVector&&) noexcept = default;
+
+    MappedTVector& operator=(const MappedTVector&) = delete;
+    MappedTVector& operator=(MappedTVector&&) noexcept = default;
+
+    inline T* data() noexcept;
+    inline const T* data() const noexcept;
+    inline size_type size() const noexcept;
+    inline size_type capacity() const noexcept;
+    inline bool is_empty() const noexcept;
+
+    inline reference operator[](size_type index);
+    inline const_reference operator[](size_type index) const;
+    inline reference front();
+    inline reference back();
+
+    inline iterator begin() noexcept;
+    inline iterator end() noexcept;
+    inline const_iterator begin() const noexcept;
+    inline const_iterator end() const noexcept;
+
+    void push_back(const T& value);
+    void pop_back();
+    template<class ForwardIt>
+    void append(ForwardIt first, ForwardIt last);
+    void resize(size_type new_size);
+    void reserve(size_type new_capacity);
+    void shrink_to_fit();
+    void clear() noexcept;
+    void flush();
+
+ private:
+    inline Header* header() const noexcept;
+    size_type next_capacity(size_type new_size) const noexcept;
+    void remap(size_type new_capacity);
+};
+
+template<typename T>
+MappedTVector<T>::MappedTVector(const std::string& path) : _file(path) {
+    if (_file.size() == 0) {
+        _file.resize(_data_offset);
+
+        Header* created = header();
+        created->magic = _magic;
+        created->element_size = sizeof(T);
+        created->size = 0;
+        return;
+    }
+
+    if (_file.size() < _data_offset || header()->magic != _magic) {
+        throw std::runtime_error("MappedTVector: " + path +
+            " is not a mapped vector");
+    }
+
+    if (header()->element_size != sizeof(T)) {
+        throw std::runtime_error("MappedTVector: " + path +
+            " holds elements of another size");
+    }
+
+    if (header()->size > capacity()) {
+        throw std::runtime_error("MappedTVector: " + path + " is truncated");
+    }
+}
+
+template<typename T>
+inline T* MappedTVector<T>::data() noexcept {
+    if (_file.data() == nullptr)
+        return nullptr;
+
+    return reinterpret_cast<T*>(static_cast<char*>(_file.data()) +
+        _data_offset);
+}
+
+template<typename T>
+inline const T* MappedTVector<T>::data() const noexcept {
+    if (_file.data() == nullptr)
+        return nullptr;
+
+    return reinterpret_cast<const T*>(static_cast<const char*>(_file.data()) +
+        _data_offset);
+}
+
+template<typename T>
+inline typename MappedTVector<T>::size_type MappedTVector<T>::size()
+const noexcept {
+    if (_file.data() == nullptr)
+        return 0;
+
+    return static_cast<size_type>(header()->size);
+}
+
+template<typename T>
+inline typename MappedTVector<T>::size_type MappedTVector<T>::capacity()
+const noexcept {
+    if (_file.size() < _data_offset)
+        return 0;
+
+    return (_file.size() - _data_offset) / sizeof(T);
+}
+
+template<typename T>
+inline bool MappedTVector<T>::is_empty() const noexcept {
+    return size() == 0;
+}
+
+template<typename T>
+inline typename MappedTVector<T>::reference
+MappedTVector<T>::operator[](size_type index) {
+    if (index >= size()) {
+        throw std::out_of_range("MappedTVector operator[]: Index out of "
+            "range.");
+    }
+
+    return data()[index];
+}
+
+template<typename T>
+inline typename MappedTVector<T>::const_reference
+MappedTVector<T>::operator[](size_type index) const {
+    if (index >= size()) {
+        throw std::out_of_range("MappedTVector operator[]: Index out of "
+            "range.");
+    }
+
+    return data()[index];
+}
+
+template<typename T>
+inline typename MappedTVector<T>::reference MappedTVector<T>::front() {
+    if (is_empty()) {
+        throw std::runtime_error("front() called on empty MappedTVector");
+    }
+
+    return data()[0];
+}
+
+template<typename T>
+inline typename MappedTVector<T>::reference MappedTVector<T>::back() {
+    if (is_empty()) {
+        throw std::runtime_error("back() called on empty MappedTVector");
+    }
+
+    return data()[size() - 1];
+}
+
+template<typename T>
+inline typename MappedTVector<T>::iterator MappedTVector<T>::begin()
+noexcept {
+    return data();
+}
+
+template<typename T>
+inline typename MappedTVector<T>::iterator MappedTVector<T>::end() noexcept {
+    return data() + size();
+}
+
+template<typename T>
+inline typename MappedTVector<T>::const_iterator MappedTVector<T>::begin()
+const noexcept {
+    return data();
+}
+
+template<typename T>
+inline typename MappedTVector<T>::const_iterator MappedTVector<T>::end()
+const noexcept {
+    return data() + size();
+}
+
+template<typename T>
+void MappedTVector<T>::push_back(const T& value) {
+    if (size() == capacity()) {
+        // value may live in the mapping that is about to move.
+        T copy(value);
+        remap(next_capacity(size() + 1));
+        data()[size()] = copy;
+    } else {
+        data()[size()] = value;
+    }
+
+    header()->size++;
+}
+
+template<typename T>
+void MappedTVector<T>::pop_back() {
+    if (is_empty())
+        throw std::runtime_error("Pop with empty vector");
+
+    header()->size--;
+}
+
+// The range must not point into this vector.
+template<typename T>
+template<class ForwardIt>
+void MappedTVector<T>::append(ForwardIt first, ForwardIt last) {
+    size_type n = std::distance(first, last);
+
+    if (size() + n > capacity())
+        remap(next_capacity(size() + n));
+
+    T* out = data() + size();
+
+    for (; first != last; ++first, ++out) {
+        *out = *first;
+    }
+
+    header()->size += n;
+}
+
+// New elements are value-initialized.
+template<typename T>
+void MappedTVector<T>::resize(size_type new_size) {
+    if (new_size > capacity())
+        remap(next_capacity(new_size));
+
+    for (size_type i = size(); i < new_size; i++) {
+        data()[i] = T();
+    }
+
+    header()->size = new_size;
+}
+
+template<typename T>
+void MappedTVector<T>::reserve(size_type new_capacity) {
+    if (new_capacity > capacity())
+        remap(new_capacity);
+}
+
+// Cuts the file down to the elements in use.
+template<typename T>
+void MappedTVector<T>::shrink_to_fit() {
+    if (size() < capacity())
+        remap(size());
+}
+
+template<typename T>
+void MappedTVector<T>::clear() noexcept {
+    if (_file.data() == nullptr)
+        return;
+
+    header()->size = 0;
+}
+
+template<typename T>
+void MappedTVector<T>::flush() {
+    _file.flush();
+}
+
+template<typename T>
+inline typename MappedTVector<T>::Header* MappedTVector<T>::header()
+const noexcept {
+    return static_cast<Header*>(_file.data());
+}
+
+template<typename T>
+typename MappedTVector<T>::size_type
+MappedTVector<T>::next_capacity(size_type new_size) const noexcept {
+    size_type new_capacity = (new_size / _capacity_step + 1) * _capacity_step;
+
+    if (new_capacity < capacity() * 2)
+        new_capacity = capacity() * 2;
+
+    return new_capacity;
+}
+
+template<typename T>
+void MappedTVector<T>::remap(size_type new_capacity) {
+    _file.resize(_data_offset + new_capacity * sizeof(T));
+}
+
+#endif  // LIBS_LIB_MAPPED_TVECTOR_MAPPED_TVECTOR_H_
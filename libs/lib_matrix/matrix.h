@@ -3,12 +3,21 @@
 #ifndef LIBS_LIB_MATRIX_MATRIX_H_
 #define LIBS_LIB_MATRIX_MATRIX_H_
 
+#include <algorithm>
+#include <new>
 #include <sstream>
 #include <string>
 #include <iomanip>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "libs/lib_memory_resource/memory_resource.h"
 #include "libs/lib_mvector/mvector.h"
 #include "libs/lib_tvector/tvector.h"
 
+template<typename T>
+class Matrix;
+
 namespace matrix_detail {
 template <typename T>
 size_t get_element_display_width(const T& element) {
@@ -17,42 +26,332 @@ size_t get_element_display_width(const T& element) {
     ss << element;
     return ss.str().length();
 }
+
+// Rows are padded to whole cache lines once a row fills at least one, so
+// every row starts on a line boundary. Shorter rows are packed.
+const size_t cache_line = 64;
+
+template<typename T>
+inline bool padded_rows(size_t cols) noexcept {
+    return cache_line % sizeof(T) == 0 && alignof(T) <= cache_line
+        && cols >= cache_line / sizeof(T);
+}
+
+// Distance in elements between the starts of two neighbouring rows.
+template<typename T>
+inline size_t leading_dimension(size_t cols) noexcept {
+    if (!padded_rows<T>(cols)) {
+        return cols;
+    }
+
+    const size_t line = cache_line / sizeof(T);
+
+    return (cols + line - 1) / line * line;
+}
+
+template<typename T>
+inline size_t storage_alignment(size_t cols) noexcept {
+    return padded_rows<T>(cols) ? cache_line : alignof(T);
 }
 
+// matrix[i]: a view of one row inside the matrix buffer, valid while the
+// matrix keeps its shape. Assignments write the elements, they do not
+// rebind the view, and a row takes part in MVector expressions like any
+// vector:
+//
+//     matrix[0] -= matrix[1] * 2;
+//     MVector<int> sum = matrix[0] + matrix[1];
+template<typename T>
+class MatrixRow : public mvector_detail::VectorExpression<MatrixRow<T>> {
+ private:
+    T* _data;
+    size_t _size;
+
+ public:
+    using value_type = std::remove_const_t<T>;
+
+    MatrixRow(T* data, size_t size) noexcept : _data(data), _size(size) {}
+    MatrixRow(const MatrixRow&) = default;
+
+    MatrixRow& operator=(const MatrixRow& other) {
+        const mvector_detail::VectorExpression<MatrixRow>& e = other;
+
+        return *this = e;
+    }
+
+    template<class E>
+    MatrixRow& operator=(const mvector_detail::VectorExpression<E>& other) {
+        typename mvector_detail::Operand<E>::type e =
+            mvector_detail::operand(other);
+
+        if (e.size() != _size) {
+            throw std::invalid_argument("Matrix: Incompatible sizes");
+        }
+
+        mvector_detail::evaluate(_data, e);
+        return *this;
+    }
+
+    template<class E>
+    MatrixRow& operator+=(const mvector_detail::VectorExpression<E>& other) {
+        return *this = *this + other;
+    }
+
+    template<class E>
+    MatrixRow& operator-=(const mvector_detail::VectorExpression<E>& other) {
+        return *this = *this - other;
+    }
+
+    MatrixRow& operator*=(const value_type& scalar) {
+        return *this = *this * scalar;
+    }
+
+    MatrixRow& operator/=(const value_type& scalar) {
+        return *this = *this / scalar;
+    }
+
+    inline T& operator[](size_t index) const {
+        if (index >= _size) {
+            throw std::out_of_range("Matrix: Index out of range");
+        }
+
+        return _data[index];
+    }
+
+    inline size_t size() const noexcept {
+        return _size;
+    }
+
+    inline T* data() const noexcept {
+        return _data;
+    }
+};
+
+// Element-wise matrix expressions, lazy like the MVector ones: every row
+// of a node is an MVector expression over the same rows of its operands,
+// so a + b - c * s fills each row of the destination in one pass.
+template<class E>
+struct MatrixExpression {
+    inline const E& self() const noexcept {
+        return static_cast<const E&>(*this);
+    }
+};
+
+template<class E>
+struct IsMatrix : std::false_type {};
+
+template<typename T>
+struct IsMatrix<Matrix<T>> : std::true_type {};
+
+template<typename T>
+class MatrixTerminal : public MatrixExpression<MatrixTerminal<T>> {
+ private:
+    const Matrix<T>* _matrix;
+
+ public:
+    using value_type = T;
+
+    explicit MatrixTerminal(const Matrix<T>& matrix) noexcept :
+        _matrix(&matrix) {}
+
+    inline size_t rows() const noexcept {
+        return _matrix->rows();
+    }
+
+    inline size_t cols() const noexcept {
+        return _matrix->cols();
+    }
+
+    inline mvector_detail::Terminal<T> row(size_t index) const noexcept {
+        return mvector_detail::Terminal<T>(
+            _matrix->data() + index * _matrix->stride(), _matrix->cols());
+    }
+};
+
+template<class E>
+struct MatrixOperand {
+    using type = E;
+};
+
 template<typename T>
-class Matrix {
+struct MatrixOperand<Matrix<T>> {
+    using type = MatrixTerminal<T>;
+};
+
+template<class E>
+inline typename MatrixOperand<E>::type operand(
+    const MatrixExpression<E>& e) {
+    return typename MatrixOperand<E>::type(e.self());
+}
+
+template<class L, class R, class Op>
+class MatrixBinary : public MatrixExpression<MatrixBinary<L, R, Op>> {
  private:
-    size_t _rows, _cols;
-    MVector<MVector<T>> _data;
+    L _left;
+    R _right;
 
  public:
+    using value_type = typename L::value_type;
+
+    MatrixBinary(const L& left, const R& right) : _left(left),
+        _right(right) {
+        if (_left.rows() != _right.rows() || _left.cols() != _right.cols()) {
+            throw std::invalid_argument("Matrix: Incompatible sizes");
+        }
+    }
+
+    inline size_t rows() const noexcept {
+        return _left.rows();
+    }
+
+    inline size_t cols() const noexcept {
+        return _left.cols();
+    }
+
+    inline auto row(size_t index) const {
+        using Left = decltype(_left.row(index));
+        using Right = decltype(_right.row(index));
+
+        return mvector_detail::Binary<Left, Right, Op>(_left.row(index),
+            _right.row(index));
+    }
+};
+
+template<class E, class Op>
+class MatrixScalar : public MatrixExpression<MatrixScalar<E, Op>> {
+ private:
+    E _matrix;
+    typename E::value_type _scalar;
+
+ public:
+    using value_type = typename E::value_type;
+
+    MatrixScalar(const E& matrix, const value_type& scalar) :
+        _matrix(matrix), _scalar(scalar) {}
+
+    inline size_t rows() const noexcept {
+        return _matrix.rows();
+    }
+
+    inline size_t cols() const noexcept {
+        return _matrix.cols();
+    }
+
+    inline auto row(size_t index) const {
+        using Row = decltype(_matrix.row(index));
+
+        return mvector_detail::Scalar<Row, Op>(_matrix.row(index), _scalar);
+    }
+};
+
+template<class L, class R>
+inline MatrixBinary<typename MatrixOperand<L>::type,
+    typename MatrixOperand<R>::type, mvector_detail::Add>
+operator+(const MatrixExpression<L>& left, const MatrixExpression<R>& right) {
+    return { operand(left), operand(right) };
+}
+
+template<class L, class R>
+inline MatrixBinary<typename MatrixOperand<L>::type,
+    typename MatrixOperand<R>::type, mvector_detail::Subtract>
+operator-(const MatrixExpression<L>& left, const MatrixExpression<R>& right) {
+    return { operand(left), operand(right) };
+}
+
+template<class E>
+inline MatrixScalar<typename MatrixOperand<E>::type, mvector_detail::Multiply>
+operator*(const MatrixExpression<E>& matrix,
+    const typename E::value_type& scalar) {
+    return { operand(matrix), scalar };
+}
+
+template<class E>
+inline MatrixScalar<typename MatrixOperand<E>::type, mvector_detail::Divide>
+operator/(const MatrixExpression<E>& matrix,
+    const typename E::value_type& scalar) {
+    if (scalar == typename E::value_type()) {
+        throw std::invalid_argument("Matrix: divide by zero");
+    }
+
+    return { operand(matrix), scalar };
+}
+
+// Products are not element-wise: an expression on the left is evaluated
+// first, Matrix * x is a member.
+template<class L, class R, typename = std::enable_if_t<!IsMatrix<L>::value>>
+Matrix<typename L::value_type> operator*(const MatrixExpression<L>& left,
+    const MatrixExpression<R>& right) {
+    return Matrix<typename L::value_type>(left.self()) * right.self();
+}
+
+template<class L, typename = std::enable_if_t<!IsMatrix<L>::value>>
+MVector<typename L::value_type> operator*(const MatrixExpression<L>& left,
+    const MVector<typename L::value_type>& column) {
+    return Matrix<typename L::value_type>(left.self()) * column;
+}
+}  // namespace matrix_detail
+
+namespace mvector_detail {
+template<typename T>
+struct Operand<matrix_detail::MatrixRow<T>> {
+    using type = Terminal<std::remove_const_t<T>>;
+};
+}  // namespace mvector_detail
+
+// Elements are kept row after row in one buffer from the memory resource,
+// row i starts at data() + i * stride().
+template<typename T>
+class Matrix : public matrix_detail::MatrixExpression<Matrix<T>> {
+ private:
+    MemoryResource* _resource;
+    size_t _rows, _cols, _stride;
+    T* _data;
+
+    template<class E>
+    using if_expression = std::enable_if_t<!matrix_detail::IsMatrix<E>::value
+        && std::is_convertible<typename E::value_type, T>::value>;
+
+    void reset(size_t rows, size_t cols);
+    void release() noexcept;
+
+ public:
+    using value_type = T;
+
     Matrix();
     Matrix(size_t, size_t);
+    Matrix(size_t, size_t, MemoryResource*);
     Matrix(std::initializer_list<std::initializer_list<T>>);
     Matrix(const Matrix<T>&);
+    Matrix(Matrix<T>&&) noexcept;
+    template<class E, typename = if_expression<E>>
+    Matrix(const matrix_detail::MatrixExpression<E>&);  // NOLINT
+    ~Matrix();
 
     size_t rows() const;
     size_t cols() const;
+    size_t stride() const;
+    MemoryResource* resource() const;
+    T* data() noexcept;
+    const T* data() const noexcept;
 
-    MVector<T>& operator[](size_t index);
-    const MVector<T>& operator[](size_t index) const;
+    matrix_detail::MatrixRow<T> operator[](size_t index);
+    matrix_detail::MatrixRow<const T> operator[](size_t index) const;
 
-    Matrix<T> operator+(const Matrix<T>&) const;
-    Matrix<T> operator-(const Matrix<T>&) const;
     Matrix<T> operator*(const Matrix<T>&) const;
 
     Matrix<T>& operator+=(const Matrix<T>&);
     Matrix<T>& operator-=(const Matrix<T>&);
     Matrix<T>& operator*=(const Matrix<T>&);
 
-    Matrix<T> operator*(const T&) const;
-    Matrix<T> operator/(const T&) const;
     Matrix<T>& operator*=(const T&);
     Matrix<T>& operator/=(const T&);
 
     MVector<T> operator*(const MVector<T>&) const;
 
     Matrix<T>& operator=(const Matrix<T>&);
+    Matrix<T>& operator=(Matrix<T>&&);
+    template<class E, typename = if_expression<E>>
+    Matrix<T>& operator=(const matrix_detail::MatrixExpression<E>&);
 
     bool operator==(const Matrix<T>& other) const;
     bool operator!=(const Matrix<T>& other) const;
@@ -67,46 +366,120 @@ class Matrix {
 };
 
 template<typename T>
-Matrix<T>::Matrix() : _rows(0), _cols(0), _data() {}
+Matrix<T>::Matrix() : _resource(get_default_resource()), _rows(0), _cols(0),
+    _stride(0), _data(nullptr) {}
 
 template<typename T>
-Matrix<T>::Matrix(size_t rows, size_t cols) : _rows(rows), _cols(cols) {
-    _data = MVector<MVector<T>>(rows);
+Matrix<T>::Matrix(size_t rows, size_t cols) :
+    Matrix(rows, cols, get_default_resource()) {}
 
-    for (size_t i = 0; i < rows; i++) {
-        _data[i] = MVector<T>(cols);
-    }
+template<typename T>
+Matrix<T>::Matrix(size_t rows, size_t cols, MemoryResource* resource) :
+    _resource(resource), _rows(0), _cols(0), _stride(0), _data(nullptr) {
+    reset(rows, cols);
 }
 
 template<typename T>
-Matrix<T>::Matrix(std::initializer_list<std::initializer_list<T>> init) {
-    _rows = init.size();
-
-    if (_rows > 0) {
-        _cols = init.begin()->size();
-    } else {
-        _cols = 0;
-    }
+Matrix<T>::Matrix(std::initializer_list<std::initializer_list<T>> init) :
+    Matrix() {
+    size_t cols = init.size() > 0 ? init.begin()->size() : 0;
 
     for (const auto& row : init) {
-        if (row.size() != _cols) {
+        if (row.size() != cols) {
             throw std::invalid_argument("Matrix: All rows"
                                         " must have the same length");
         }
     }
 
-    _data = MVector<MVector<T>>(_rows);
-    size_t i = 0;
+    reset(init.size(), cols);
+    T* row = _data;
 
     for (const auto& row_list : init) {
-        _data[i] = MVector<T>(row_list);
-        ++i;
+        std::copy(row_list.begin(), row_list.end(), row);
+        row += _stride;
     }
 }
 
 template<typename T>
-Matrix<T>::Matrix(const Matrix<T>& other) :
-_rows(other._rows), _cols(other._cols), _data(other._data) {}
+Matrix<T>::Matrix(const Matrix<T>& other) : Matrix() {
+    *this = other;
+}
+
+// The other matrix is left 0 x 0.
+template<typename T>
+Matrix<T>::Matrix(Matrix<T>&& other) noexcept : _resource(other._resource),
+    _rows(other._rows), _cols(other._cols), _stride(other._stride),
+    _data(other._data) {
+    other._data = nullptr;
+    other._rows = 0;
+    other._cols = 0;
+    other._stride = 0;
+}
+
+template<typename T>
+template<class E, typename>
+Matrix<T>::Matrix(const matrix_detail::MatrixExpression<E>& expression) :
+    Matrix(expression.self().rows(), expression.self().cols()) {
+    *this = expression;
+}
+
+template<typename T>
+Matrix<T>::~Matrix() {
+    release();
+}
+
+// Gives the matrix a new buffer of value-initialized elements.
+template<typename T>
+void Matrix<T>::reset(size_t rows, size_t cols) {
+    size_t stride = matrix_detail::leading_dimension<T>(cols);
+    size_t count = rows * stride;
+    T* data = nullptr;
+
+    if (count > 0) {
+        data = static_cast<T*>(_resource->allocate(count * sizeof(T),
+            matrix_detail::storage_alignment<T>(cols)));
+        size_t i = 0;
+
+        try {
+            for (; i < count; i++) {
+                new (data + i) T();
+            }
+        } catch (...) {
+            while (i > 0) {
+                data[--i].~T();
+            }
+
+            _resource->deallocate(data, count * sizeof(T),
+                matrix_detail::storage_alignment<T>(cols));
+            throw;
+        }
+    }
+
+    release();
+    _rows = rows;
+    _cols = cols;
+    _stride = stride;
+    _data = data;
+}
+
+template<typename T>
+void Matrix<T>::release() noexcept {
+    if (_data != nullptr) {
+        size_t count = _rows * _stride;
+
+        for (size_t i = 0; i < count; i++) {
+            _data[i].~T();
+        }
+
+        _resource->deallocate(_data, count * sizeof(T),
+            matrix_detail::storage_alignment<T>(_cols));
+    }
+
+    _data = nullptr;
+    _rows = 0;
+    _cols = 0;
+    _stride = 0;
+}
 
 template<typename T>
 size_t Matrix<T>::rows() const {
@@ -119,43 +492,41 @@ size_t Matrix<T>::cols() const {
 }
 
 template<typename T>
-MVector<T>& Matrix<T>::operator[](size_t index) {
-    return _data[index];
+size_t Matrix<T>::stride() const {
+    return _stride;
 }
 
 template<typename T>
-const MVector<T>& Matrix<T>::operator[](size_t index) const {
-    return _data[index];
+MemoryResource* Matrix<T>::resource() const {
+    return _resource;
 }
 
 template<typename T>
-Matrix<T> Matrix<T>::operator+(const Matrix<T>& other) const {
-    if (_rows != other._rows || _cols != other._cols) {
-        throw std::invalid_argument("Matrix: Incompatible sizes");
-    }
-
-    Matrix<T> result(_rows, _cols);
-
-    for (size_t i = 0; i < _rows; i++) {
-        result._data[i] = _data[i] + other._data[i];
-    }
+T* Matrix<T>::data() noexcept {
+    return _data;
+}
 
-    return result;
+template<typename T>
+const T* Matrix<T>::data() const noexcept {
+    return _data;
 }
 
 template<typename T>
-Matrix<T> Matrix<T>::operator-(const Matrix<T>& other) const {
-    if (_rows != other._rows || _cols != other._cols) {
-        throw std::invalid_argument("Matrix: Incompatible sizes");
+matrix_detail::MatrixRow<T> Matrix<T>::operator[](size_t index) {
+    if (index >= _rows) {
+        throw std::out_of_range("Matrix: Index out of range");
     }
 
-    Matrix<T> result(_rows, _cols);
+    return { _data + index * _stride, _cols };
+}
 
-    for (size_t i = 0; i < _rows; i++) {
-        result._data[i] = _data[i] - other._data[i];
+template<typename T>
+matrix_detail::MatrixRow<const T> Matrix<T>::operator[](size_t index) const {
+    if (index >= _rows) {
+        throw std::out_of_range("Matrix: Index out of range");
     }
 
-    return result;
+    return { _data + index * _stride, _cols };
 }
 
 template<typename T>
@@ -168,8 +539,11 @@ Matrix<T> Matrix<T>::operator*(const Matrix<T>& other) const {
     Matrix<T> other_transpose = other.transpose();
 
     for (size_t i = 0; i < _rows; i++) {
+        T* row = result._data + i * result._stride;
+
         for (size_t j = 0; j < other._cols; j++) {
-            result._data[i][j] = _data[i] * other_transpose._data[j];
+            row[j] = mvector_detail::dot(_data + i * _stride,
+                other_transpose._data + j * other_transpose._stride, _cols);
         }
     }
 
@@ -194,28 +568,6 @@ Matrix<T> & Matrix<T>::operator*=(const Matrix<T>& other) {
     return *this;
 }
 
-template<typename T>
-Matrix<T> Matrix<T>::operator*(const T& scalar) const {
-    Matrix<T> result(_rows, _cols);
-
-    for (size_t i = 0; i < _rows; i++) {
-        result._data[i] = _data[i] * scalar;
-    }
-
-    return result;
-}
-
-template<typename T>
-Matrix<T> Matrix<T>::operator/(const T& scalar) const {
-    Matrix<T> result(_rows, _cols);
-
-    for (size_t i = 0; i < _rows; i++) {
-        result._data[i] = _data[i] / scalar;
-    }
-
-    return result;
-}
-
 template<typename T>
 Matrix<T>& Matrix<T>::operator*=(const T& scalar) {
     *this = *this * scalar;
@@ -230,24 +582,84 @@ Matrix<T>& Matrix<T>::operator/=(const T& scalar) {
 
 template<typename T>
 MVector<T> Matrix<T>::operator*(const MVector<T>& column) const {
+    if (_cols != column.size()) {
+        throw std::invalid_argument("Matrix: Incompatible sizes");
+    }
+
     MVector<T> result(_rows);
 
     for (size_t i = 0; i < _rows; i++) {
-        result[i] = _data[i] * column;
+        result[i] = mvector_detail::dot(_data + i * _stride, column.data(),
+            _cols);
     }
 
     return result;
 }
 
+// Keeps the resource of this matrix, the buffer is reused when the shapes
+// match.
 template<typename T>
 Matrix<T>& Matrix<T>::operator=(const Matrix<T>& other) {
     if (this == &other) {
         return *this;
     }
 
-    _cols = other._cols;
+    if (_rows != other._rows || _cols != other._cols) {
+        reset(other._rows, other._cols);
+    }
+
+    for (size_t i = 0; i < _rows; i++) {
+        const T* row = other._data + i * other._stride;
+
+        std::copy(row, row + _cols, _data + i * _stride);
+    }
+
+    return *this;
+}
+
+// Storage can not change hands between resources, then the elements are
+// copied, which may throw.
+template<typename T>
+Matrix<T>& Matrix<T>::operator=(Matrix<T>&& other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    if (_resource != other._resource) {
+        *this = other;
+        other.release();
+        return *this;
+    }
+
+    release();
     _rows = other._rows;
+    _cols = other._cols;
+    _stride = other._stride;
     _data = other._data;
+    other._data = nullptr;
+    other._rows = 0;
+    other._cols = 0;
+    other._stride = 0;
+
+    return *this;
+}
+
+template<typename T>
+template<class E, typename>
+Matrix<T>& Matrix<T>::operator=(
+    const matrix_detail::MatrixExpression<E>& expression) {
+    const E& e = expression.self();
+
+    if (e.rows() != _rows || e.cols() != _cols) {
+        Matrix<T> result(e.rows(), e.cols(), _resource);
+
+        result = expression;
+        return *this = std::move(result);
+    }
+
+    for (size_t i = 0; i < _rows; i++) {
+        mvector_detail::evaluate(_data + i * _stride, e.row(i));
+    }
 
     return *this;
 }
@@ -259,7 +671,9 @@ bool Matrix<T>::operator==(const Matrix<T>& other) const {
     }
 
     for (size_t i = 0; i < _rows; i++) {
-        if (_data[i] != other._data[i]) {
+        const T* row = _data + i * _stride;
+
+        if (!std::equal(row, row + _cols, other._data + i * other._stride)) {
             return false;
         }
     }
@@ -278,7 +692,7 @@ Matrix<T> Matrix<T>::transpose() const {
 
     for (size_t i = 0; i < _rows; i++) {
         for (size_t j = 0; j < _cols; j++) {
-            result._data[j][i] = _data[i][j];
+            result._data[j * result._stride + i] = _data[i * _stride + j];
         }
     }
 
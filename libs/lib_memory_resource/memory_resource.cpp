@@ -0,0 +1,230 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_memory_resource/memory_resource.h"
+
+#include <cstdint>
+#include <new>
+
+namespace {
+const size_t max_alignment = alignof(std::max_align_t);
+
+thread_local MemoryResource* thread_default_resource = nullptr;
+
+size_t align_up(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+}  // namespace
+
+// Over-aligned blocks keep the pointer operator new returned right before
+// the aligned address.
+void* NewDeleteResource::allocate(size_t bytes, size_t alignment) {
+    if (alignment <= max_alignment) {
+        return ::operator new(bytes);
+    }
+
+    uintptr_t raw = reinterpret_cast<uintptr_t>(
+        ::operator new(bytes + alignment));
+    uintptr_t aligned = align_up(raw + sizeof(void*), alignment);
+
+    reinterpret_cast<void**>(aligned)[-1] = reinterpret_cast<void*>(raw);
+    return reinterpret_cast<void*>(aligned);
+}
+
+void NewDeleteResource::deallocate(void* ptr, size_t, size_t alignment)
+noexcept {
+    if (alignment > max_alignment && ptr != nullptr) {
+        ptr = static_cast<void**>(ptr)[-1];
+    }
+
+    ::operator delete(ptr);
+}
+
+MonotonicArena::MonotonicArena(size_t initial_size, MemoryResource* upstream)
+    : _upstream(upstream ? upstream : new_delete_resource()),
+    _chunks(nullptr), _current(nullptr), _left(0),
+    _next_chunk_size(initial_size > 0 ? initial_size : 1),
+    _initial_size(_next_chunk_size) {}
+
+MonotonicArena::~MonotonicArena() noexcept {
+    release();
+}
+
+void* MonotonicArena::allocate(size_t bytes, size_t alignment) {
+    size_t padding = align_up(reinterpret_cast<uintptr_t>(_current),
+        alignment) - reinterpret_cast<uintptr_t>(_current);
+
+    if (_current == nullptr || padding + bytes > _left) {
+        add_chunk(bytes + alignment);
+        padding = align_up(reinterpret_cast<uintptr_t>(_current),
+            alignment) - reinterpret_cast<uintptr_t>(_current);
+    }
+
+    void* result = _current + padding;
+    _current += padding + bytes;
+    _left -= padding + bytes;
+
+    return result;
+}
+
+void MonotonicArena::deallocate(void*, size_t, size_t)
+noexcept {}
+
+void MonotonicArena::release() noexcept {
+    while (_chunks != nullptr) {
+        Chunk* next = _chunks->next;
+        _upstream->deallocate(_chunks, _chunks->size, max_alignment);
+        _chunks = next;
+    }
+
+    _current = nullptr;
+    _left = 0;
+    _next_chunk_size = _initial_size;
+}
+
+size_t MonotonicArena::reserved() const noexcept {
+    size_t total = 0;
+
+    for (Chunk* chunk = _chunks; chunk != nullptr; chunk = chunk->next) {
+        total += chunk->size;
+    }
+
+    return total;
+}
+
+void MonotonicArena::add_chunk(size_t min_size) {
+    size_t header = align_up(sizeof(Chunk), max_alignment);
+    size_t size = _next_chunk_size > min_size ? _next_chunk_size : min_size;
+
+    Chunk* chunk = static_cast<Chunk*>(_upstream->allocate(header + size,
+        max_alignment));
+    chunk->next = _chunks;
+    chunk->size = header + size;
+    _chunks = chunk;
+
+    _current = reinterpret_cast<char*>(chunk) + header;
+    _left = size;
+    _next_chunk_size = size * 2;
+}
+
+PoolResource::PoolResource(MemoryResource* upstream)
+    : _upstream(upstream ? upstream : new_delete_resource()),
+    _chunks(nullptr) {
+    for (size_t i = 0; i < _classes; i++) {
+        _free[i] = nullptr;
+    }
+}
+
+PoolResource::~PoolResource() noexcept {
+    release();
+}
+
+void* PoolResource::allocate(size_t bytes, size_t alignment) {
+    size_t index = size_class(bytes, alignment);
+
+    if (index == _classes)
+        return _upstream->allocate(bytes, alignment);
+
+    if (_free[index] == nullptr)
+        refill(index);
+
+    Block* block = _free[index];
+    _free[index] = block->next;
+
+    return block;
+}
+
+void PoolResource::deallocate(void* ptr, size_t bytes, size_t alignment)
+noexcept {
+    if (ptr == nullptr)
+        return;
+
+    size_t index = size_class(bytes, alignment);
+
+    if (index == _classes) {
+        _upstream->deallocate(ptr, bytes, alignment);
+        return;
+    }
+
+    Block* block = static_cast<Block*>(ptr);
+    block->next = _free[index];
+    _free[index] = block;
+}
+
+void PoolResource::release() noexcept {
+    while (_chunks != nullptr) {
+        Chunk* next = _chunks->next;
+        _upstream->deallocate(_chunks, _chunks->size, max_alignment);
+        _chunks = next;
+    }
+
+    for (size_t i = 0; i < _classes; i++) {
+        _free[i] = nullptr;
+    }
+}
+
+// Index of the smallest class that fits bytes with the given alignment,
+// _classes when the request has to go to upstream.
+size_t PoolResource::size_class(size_t bytes, size_t alignment) noexcept {
+    size_t block = _min_block;
+    size_t index = 0;
+
+    if (alignment > max_alignment)
+        return _classes;
+
+    while (block < bytes || block < alignment) {
+        block *= 2;
+        index++;
+
+        if (index == _classes)
+            return _classes;
+    }
+
+    return index;
+}
+
+void PoolResource::refill(size_t size_class) {
+    size_t header = align_up(sizeof(Chunk), max_alignment);
+    size_t block = _min_block << size_class;
+    size_t count = _chunk_bytes / block > 0 ? _chunk_bytes / block : 1;
+
+    Chunk* chunk = static_cast<Chunk*>(_upstream->allocate(
+        header + block * count, max_alignment));
+    chunk->next = _chunks;
+    chunk->size = header + block * count;
+    _chunks = chunk;
+
+    char* first = reinterpret_cast<char*>(chunk) + header;
+
+    for (size_t i = count; i > 0; i--) {
+        Block* free_block = reinterpret_cast<Block*>(first + (i - 1) * block);
+        free_block->next = _free[size_class];
+        _free[size_class] = free_block;
+    }
+}
+
+MemoryResource* new_delete_resource() noexcept {
+    static NewDeleteResource resource;
+
+    return &resource;
+}
+
+MemoryResource* get_default_resource() noexcept {
+    if (thread_default_resource == nullptr)
+        return new_delete_resource();
+
+    return thread_default_resource;
+}
+
+MemoryResource* set_default_resource(MemoryResource* resource) noexcept {
+    MemoryResource* previous = get_default_resource();
+    thread_default_resource = resource;
+
+    return previous;
+}
+
+ScopedDefaultResource::ScopedDefaultResource(MemoryResource* resource)
+noexcept : _previous(set_default_resource(resource)) {}
+
+ScopedDefaultResource::~ScopedDefaultResource() noexcept {
+    set_default_resource(_previous);
+}
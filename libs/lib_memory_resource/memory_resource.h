@@ -0,0 +1,119 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_MEMORY_RESOURCE_MEMORY_RESOURCE_H_
+#define LIBS_LIB_MEMORY_RESOURCE_MEMORY_RESOURCE_H_
+
+#include <cstddef>
+
+// Source of raw memory for the containers. Alignments are powers of two,
+// the resources here support any of them: larger than
+// alignof(std::max_align_t) costs up to alignment extra bytes.
+class MemoryResource {
+ public:
+    virtual ~MemoryResource() = default;
+    virtual void* allocate(size_t bytes, size_t alignment) = 0;
+    virtual void deallocate(void* ptr, size_t bytes, size_t alignment)
+        noexcept = 0;
+};
+
+class NewDeleteResource : public MemoryResource {
+ public:
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes, size_t alignment)
+        noexcept override;
+};
+
+// Bump allocator over chunks taken from upstream. deallocate() does nothing,
+// everything is given back at once by release() or the destructor.
+class MonotonicArena : public MemoryResource {
+ private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    MemoryResource* _upstream;
+    Chunk* _chunks;
+    char* _current;
+    size_t _left;
+    size_t _next_chunk_size;
+    size_t _initial_size;
+
+ public:
+    explicit MonotonicArena(size_t initial_size = 4096,
+        MemoryResource* upstream = nullptr);
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    ~MonotonicArena() noexcept;
+
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes, size_t alignment)
+        noexcept override;
+
+    void release() noexcept;
+    size_t reserved() const noexcept;
+
+ private:
+    void add_chunk(size_t min_size);
+};
+
+// Free lists per power-of-two size class from 8 to 4096 bytes, refilled in
+// chunks from upstream. Larger requests go straight to upstream. Freed
+// blocks are only reused, release() or the destructor return the chunks.
+class PoolResource : public MemoryResource {
+ private:
+    static const size_t _classes = 10;
+    static const size_t _min_block = 8;
+    static const size_t _max_block = _min_block << (_classes - 1);
+    static const size_t _chunk_bytes = 16 * 1024;
+
+    struct Block {
+        Block* next;
+    };
+
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    MemoryResource* _upstream;
+    Chunk* _chunks;
+    Block* _free[_classes];
+
+ public:
+    explicit PoolResource(MemoryResource* upstream = nullptr);
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+    ~PoolResource() noexcept;
+
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes, size_t alignment)
+        noexcept override;
+
+    void release() noexcept;
+
+ private:
+    static size_t size_class(size_t bytes, size_t alignment) noexcept;
+    void refill(size_t size_class);
+};
+
+MemoryResource* new_delete_resource() noexcept;
+
+// The resource containers use when none is given. It is kept per thread,
+// nullptr restores new_delete_resource(). Returns the previous one.
+MemoryResource* get_default_resource() noexcept;
+MemoryResource* set_default_resource(MemoryResource* resource) noexcept;
+
+// Makes resource the default of the calling thread for the scope lifetime.
+class ScopedDefaultResource {
+ private:
+    MemoryResource* _previous;
+
+ public:
+    explicit ScopedDefaultResource(MemoryResource* resource) noexcept;
+    ScopedDefaultResource(const ScopedDefaultResource&) = delete;
+    ScopedDefaultResource& operator=(const ScopedDefaultResource&) = delete;
+    ~ScopedDefaultResource() noexcept;
+};
+
+#endif  // LIBS_LIB_MEMORY_RESOURCE_MEMORY_RESOURCE_H_
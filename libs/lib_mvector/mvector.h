@@ -4,25 +4,304 @@
 #define LIBS_LIB_MVECTOR_MVECTOR_H_
 
 #include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "libs/lib_mvector/mvector_kernels.h"
 #include "libs/lib_tvector/tvector.h"
 
 template<typename T>
-class MVector {
+class MVector;
+
+// a + b - c * s does not compute anything by itself: the operators build
+// a small tree of nodes and assigning it to an MVector evaluates the whole
+// expression in one loop straight into the destination, without temporary
+// vectors. Sizes are checked when the tree is built. The nodes refer to
+// the vectors they read, so keep them within the statement: write the
+// result type, auto would hold the expression.
+namespace mvector_detail {
+
+template<class E>
+struct VectorExpression {
+    inline const E& self() const noexcept {
+        return static_cast<const E&>(*this);
+    }
+};
+
+template<class E>
+struct IsMVector : std::false_type {};
+
+template<typename T>
+struct IsMVector<MVector<T>> : std::true_type {};
+
+// Leaf of the tree, reads the elements of an MVector or of any other
+// vector that keeps them in one array.
+template<typename T>
+class Terminal : public VectorExpression<Terminal<T>> {
+ private:
+    const T* _data;
+    size_t _size;
+
+ public:
+    using value_type = T;
+
+    template<class V>
+    explicit Terminal(const V& vec) noexcept : _data(vec.data()),
+        _size(vec.size()) {}
+
+    Terminal(const T* data, size_t size) noexcept : _data(data),
+        _size(size) {}
+
+    inline size_t size() const noexcept {
+        return _size;
+    }
+
+    inline const T* data() const noexcept {
+        return _data;
+    }
+
+    inline const T& operator[](size_t index) const noexcept {
+        return _data[index];
+    }
+};
+
+// How a node stores its operand: vectors by reference, nodes by value.
+template<class E>
+struct Operand {
+    using type = E;
+};
+
+template<typename T>
+struct Operand<MVector<T>> {
+    using type = Terminal<T>;
+};
+
+template<class E>
+inline typename Operand<E>::type operand(const VectorExpression<E>& e) {
+    return typename Operand<E>::type(e.self());
+}
+
+template<class L, class R, class Op>
+class Binary : public VectorExpression<Binary<L, R, Op>> {
+ private:
+    L _left;
+    R _right;
+
+ public:
+    using value_type = typename L::value_type;
+
+    Binary(const L& left, const R& right) : _left(left), _right(right) {
+        if (_left.size() != _right.size()) {
+            throw std::invalid_argument("MVector: size mismatch");
+        }
+    }
+
+    inline size_t size() const noexcept {
+        return _left.size();
+    }
+
+    inline const L& left() const noexcept {
+        return _left;
+    }
+
+    inline const R& right() const noexcept {
+        return _right;
+    }
+
+    inline auto operator[](size_t index) const {
+        return Op::apply(_left[index], _right[index]);
+    }
+};
+
+template<class E, class Op>
+class Scalar : public VectorExpression<Scalar<E, Op>> {
+ private:
+    E _vector;
+    typename E::value_type _scalar;
+
+ public:
+    using value_type = typename E::value_type;
+
+    Scalar(const E& vector, const value_type& scalar) : _vector(vector),
+        _scalar(scalar) {}
+
+    inline size_t size() const noexcept {
+        return _vector.size();
+    }
+
+    inline const E& vector() const noexcept {
+        return _vector;
+    }
+
+    inline const value_type& scalar() const noexcept {
+        return _scalar;
+    }
+
+    inline auto operator[](size_t index) const {
+        return Op::apply(_vector[index], _scalar);
+    }
+};
+
+struct Add {
+    template<class A, class B>
+    static inline auto apply(const A& a, const B& b) {
+        return a + b;
+    }
+};
+
+struct Subtract {
+    template<class A, class B>
+    static inline auto apply(const A& a, const B& b) {
+        return a - b;
+    }
+};
+
+struct Multiply {
+    template<class A, class B>
+    static inline auto apply(const A& a, const B& b) {
+        return a * b;
+    }
+};
+
+struct Divide {
+    template<class A, class B>
+    static inline auto apply(const A& a, const B& b) {
+        return a / b;
+    }
+};
+
+// Types with vectorized kernels in mvector_kernels.
+template<typename T>
+struct HasKernels : std::integral_constant<bool,
+    std::is_same<T, float>::value || std::is_same<T, double>::value ||
+    std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value> {};
+
+template<typename T>
+std::enable_if_t<!HasKernels<T>::value, T> dot(const T* a, const T* b,
+    size_t size) {
+    T result{};
+
+    for (size_t i = 0; i < size; i++) {
+        result = result + a[i] * b[i];
+    }
+
+    return result;
+}
+
+template<typename T>
+inline std::enable_if_t<HasKernels<T>::value, T> dot(const T* a,
+    const T* b, size_t size) noexcept {
+    return mvector_kernels::dot(a, b, size);
+}
+
+// Writes the elements of e to out. The plain loop is left to the compiler,
+// an expression that is one kernel call goes to mvector_kernels.
+template<typename T, class E>
+inline void evaluate(T* out, const E& e) {
+    for (size_t i = 0; i < e.size(); i++) {
+        out[i] = e[i];
+    }
+}
+
+template<typename T>
+inline std::enable_if_t<HasKernels<T>::value> evaluate(T* out,
+    const Binary<Terminal<T>, Terminal<T>, Add>& e) noexcept {
+    mvector_kernels::add(out, e.left().data(), e.right().data(), e.size());
+}
+
+template<typename T>
+inline std::enable_if_t<HasKernels<T>::value> evaluate(T* out,
+    const Binary<Terminal<T>, Terminal<T>, Subtract>& e) noexcept {
+    mvector_kernels::subtract(out, e.left().data(), e.right().data(),
+        e.size());
+}
+
+template<typename T>
+inline std::enable_if_t<HasKernels<T>::value> evaluate(T* out,
+    const Scalar<Terminal<T>, Multiply>& e) noexcept {
+    mvector_kernels::scale(out, e.vector().data(), e.scalar(), e.size());
+}
+
+template<class L, class R>
+inline Binary<typename Operand<L>::type, typename Operand<R>::type, Add>
+operator+(const VectorExpression<L>& left, const VectorExpression<R>& right) {
+    return { operand(left), operand(right) };
+}
+
+template<class L, class R>
+inline Binary<typename Operand<L>::type, typename Operand<R>::type, Subtract>
+operator-(const VectorExpression<L>& left, const VectorExpression<R>& right) {
+    return { operand(left), operand(right) };
+}
+
+template<class E>
+inline Scalar<typename Operand<E>::type, Multiply>
+operator*(const VectorExpression<E>& vector,
+    const typename E::value_type& scalar) {
+    return { operand(vector), scalar };
+}
+
+template<class E>
+inline Scalar<typename Operand<E>::type, Divide>
+operator/(const VectorExpression<E>& vector,
+    const typename E::value_type& scalar) {
+    if (scalar == typename E::value_type()) {
+        throw std::invalid_argument("MVector: divide by zero");
+    }
+
+    return { operand(vector), scalar };
+}
+
+// Dot product with an expression on the left, MVector * x is a member.
+template<class L, class R,
+    typename = std::enable_if_t<!IsMVector<L>::value>>
+typename L::value_type operator*(const VectorExpression<L>& left,
+    const VectorExpression<R>& right) {
+    typename Operand<L>::type a = operand(left);
+    typename Operand<R>::type b = operand(right);
+
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("MVector: size mismatch");
+    }
+
+    typename L::value_type result{};
+
+    for (size_t i = 0; i < a.size(); i++) {
+        result = result + a[i] * b[i];
+    }
+
+    return result;
+}
+
+}  // namespace mvector_detail
+
+template<typename T>
+class MVector : public mvector_detail::VectorExpression<MVector<T>> {
  private:
     TVector<T> _data;
 
+    template<class E>
+    using if_expression = std::enable_if_t<!mvector_detail::IsMVector<E>::value
+        && std::is_convertible<typename E::value_type, T>::value>;
+
  public:
+    using value_type = T;
+
     MVector();
+    explicit MVector(MemoryResource*);
     explicit MVector(int);
+    MVector(int, MemoryResource*);
     MVector(std::initializer_list<T> init);
     MVector(const MVector&);
+    MVector(MVector&&) noexcept;
+    template<class E, typename = if_expression<E>>
+    MVector(const mvector_detail::VectorExpression<E>&);  // NOLINT
 
     MVector<T>& operator=(const MVector<T>&);
-    MVector<T> operator+(const MVector<T>&) const;
-    MVector<T> operator-(const MVector<T>&) const;
+    MVector<T>& operator=(MVector<T>&&) noexcept;
+    template<class E, typename = if_expression<E>>
+    MVector<T>& operator=(const mvector_detail::VectorExpression<E>&);
     T operator*(const MVector<T>&) const;
-    MVector<T> operator*(T scalar) const;
-    MVector<T> operator/(T scalar) const;
     T& operator[](size_t index);
     const T& operator[](size_t index) const;
 
@@ -38,17 +317,29 @@ class MVector {
     MVector<T> normalized() const;
 
     size_t size() const;
+    T* data() noexcept;
+    const T* data() const noexcept;
+    MemoryResource* resource() const;
 };
 
 template<typename T>
 MVector<T>::MVector() : _data() {}
 
 template<typename T>
-MVector<T>::MVector(int size) {
+MVector<T>::MVector(MemoryResource* resource) : _data(resource) {}
+
+template<typename T>
+MVector<T>::MVector(int size) : MVector(size, get_default_resource()) {}
+
+template<typename T>
+MVector<T>::MVector(int size, MemoryResource* resource) : _data(resource) {
     if (size < 0) {
         throw std::invalid_argument("MVector: size must be non-negative");
     }
 
+    // Lets the temporary below take its storage from resource as well.
+    ScopedDefaultResource scope(resource);
+
     _data = TVector<T>(size);
     _data.shrink_to_fit();
 }
@@ -59,8 +350,18 @@ MVector<T>::MVector(std::initializer_list<T> init) : _data(init) {
 }
 
 template<typename T>
-MVector<T>::MVector(const MVector& other) {
-    _data = other._data;
+MVector<T>::MVector(const MVector& other) : _data(other._data) {}
+
+// The other vector is left empty.
+template<typename T>
+MVector<T>::MVector(MVector&& other) noexcept :
+    _data(std::move(other._data)) {}
+
+template<typename T>
+template<class E, typename>
+MVector<T>::MVector(const mvector_detail::VectorExpression<E>& expression) :
+    MVector(static_cast<int>(expression.self().size())) {
+    *this = expression;
 }
 
 template<typename T>
@@ -70,33 +371,30 @@ MVector<T>& MVector<T>::operator=(const MVector<T>& other) {
 }
 
 template<typename T>
-MVector<T> MVector<T>::operator+(const MVector<T>& other) const {
-    if (_data.size() != other._data.size()) {
-        throw std::invalid_argument("MVector: size mismatch");
-    }
-
-    MVector<T> result(size());
-
-    for (size_t i = 0; i < size(); i++) {
-        result[i] = _data[i] + other._data[i];
-    }
-
-    return result;
+MVector<T>& MVector<T>::operator=(MVector<T>&& other) noexcept {
+    _data = std::move(other._data);
+    return *this;
 }
 
 template<typename T>
-MVector<T> MVector<T>::operator-(const MVector<T>& other) const {
-    if (_data.size() != other._data.size()) {
-        throw std::invalid_argument("MVector: size mismatch");
+template<class E, typename>
+MVector<T>& MVector<T>::operator=(
+    const mvector_detail::VectorExpression<E>& expression) {
+    const E& e = expression.self();
+
+    // A new buffer would free the elements e may still read, so a vector
+    // of another size gets its result built aside and moved in.
+    if (e.size() != size()) {
+        ScopedDefaultResource scope(resource());
+        MVector<T> result(expression);
+
+        _data = std::move(result._data);
+        return *this;
     }
 
-    MVector<T> result(size());
+    mvector_detail::evaluate(_data.data(), e);
 
-    for (size_t i = 0; i < size(); i++) {
-        result[i] = _data[i] - other._data[i];
-    }
-
-    return result;
+    return *this;
 }
 
 template<typename T>
@@ -105,39 +403,7 @@ T MVector<T>::operator*(const MVector<T>& other) const {
         throw std::invalid_argument("MVector: size mismatch");
     }
 
-    T result{};
-
-    for (size_t i = 0; i < size(); i++) {
-        result = result + _data[i] * other._data[i];
-    }
-
-    return result;
-}
-
-template<typename T>
-MVector<T> MVector<T>::operator*(T scalar) const  {
-    MVector<T> result(size());
-
-    for (size_t i = 0; i < size(); i++) {
-        result[i] = _data[i] * scalar;
-    }
-
-    return result;
-}
-
-template<typename T>
-MVector<T> MVector<T>::operator/(T scalar) const {
-    if (scalar == T()) {
-        throw std::invalid_argument("MVector: divide by zero");
-    }
-
-    MVector<T> result(size());
-
-    for (size_t i = 0; i < size(); i++) {
-        result[i] = _data[i] / scalar;
-    }
-
-    return result;
+    return mvector_detail::dot(data(), other.data(), size());
 }
 
 template<typename T>
@@ -219,4 +485,20 @@ size_t MVector<T>::size() const {
     return _data.size();
 }
 
+// The elements are contiguous, an MVector never has Deleted slots.
+template<typename T>
+T* MVector<T>::data() noexcept {
+    return _data.data();
+}
+
+template<typename T>
+const T* MVector<T>::data() const noexcept {
+    return _data.data();
+}
+
+template<typename T>
+MemoryResource* MVector<T>::resource() const {
+    return _data.resource();
+}
+
 #endif  // LIBS_LIB_MVECTOR_MVECTOR_H_
@@ -0,0 +1,227 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_mvector/mvector_kernels.h"
+
+#include <atomic>
+#include <cstdint>
+#include "libs/lib_mvector/mvector_kernels_table.h"
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace mvector_kernels {
+namespace {
+
+using detail::Kernels;
+using detail::KernelTable;
+
+// One element per "register", what every processor can run.
+template<typename T>
+struct Portable {
+    using value = T;
+    using reg = T;
+    static const size_t lanes = 1;
+
+    static inline reg load(const T* p) { return *p; }
+    static inline void store(T* p, reg r) { *p = r; }
+    static inline reg set1(T x) { return x; }
+    static inline reg zero() { return T(); }
+    static inline reg add(reg a, reg b) { return a + b; }
+    static inline reg sub(reg a, reg b) { return a - b; }
+    static inline reg mul(reg a, reg b) { return a * b; }
+    static inline T sum(reg r) { return r; }
+};
+
+// Widest set the processor and the operating system can run.
+Isa processor_isa() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+
+    if ((info[3] & (1 << 26)) == 0)
+        return IsaScalar;
+
+    // AVX state has to be enabled by the system, not only present.
+    bool xsave = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+    uint64_t xcr0 = xsave ? _xgetbv(0) : 0;
+
+    if (max_leaf < 7 || (xcr0 & 0x6) != 0x6)
+        return IsaSSE2;
+
+    __cpuidex(info, 7, 0);
+
+    if ((info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6)
+        return IsaAVX512;
+
+    if ((info[1] & (1 << 5)) != 0)
+        return IsaAVX2;
+
+    return IsaSSE2;
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+        return IsaAVX512;
+
+    if (__builtin_cpu_supports("avx2"))
+        return IsaAVX2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return IsaSSE2;
+
+    return IsaScalar;
+#else
+    return IsaScalar;
+#endif
+}
+
+struct Tables {
+    KernelTable table[IsaAVX512 + 1];
+    Isa widest;
+};
+
+Tables make_tables() noexcept {
+    bool (*const installers[])(KernelTable*) = {
+        detail::install_sse2,
+        detail::install_avx2,
+        detail::install_avx512
+    };
+    Tables tables;
+    Isa processor = processor_isa();
+
+    detail::install<Portable<float>>(&tables.table[IsaScalar].f32);
+    detail::install<Portable<double>>(&tables.table[IsaScalar].f64);
+    detail::install<Portable<int32_t>>(&tables.table[IsaScalar].i32);
+    detail::install<Portable<int64_t>>(&tables.table[IsaScalar].i64);
+    tables.widest = IsaScalar;
+
+    for (int isa = IsaSSE2; isa <= IsaAVX512; isa++) {
+        tables.table[isa] = tables.table[isa - 1];
+
+        if (isa <= processor && tables.widest == isa - 1 &&
+            installers[isa - 1](&tables.table[isa])) {
+            tables.widest = static_cast<Isa>(isa);
+        }
+    }
+
+    return tables;
+}
+
+const Tables& tables() noexcept {
+    static const Tables instance = make_tables();
+
+    return instance;
+}
+
+std::atomic<int> active(-1);
+
+inline const KernelTable& table() noexcept {
+    int isa = active.load(std::memory_order_relaxed);
+
+    if (isa < 0) {
+        isa = tables().widest;
+        active.store(isa, std::memory_order_relaxed);
+    }
+
+    return tables().table[isa];
+}
+
+}  // namespace
+
+Isa detected_isa() noexcept {
+    return tables().widest;
+}
+
+Isa active_isa() noexcept {
+    table();
+
+    return static_cast<Isa>(active.load(std::memory_order_relaxed));
+}
+
+void use_isa(Isa isa) noexcept {
+    if (isa > detected_isa())
+        isa = detected_isa();
+
+    active.store(isa, std::memory_order_relaxed);
+}
+
+float dot(const float* a, const float* b, size_t size) noexcept {
+    return table().f32.dot(a, b, size);
+}
+
+double dot(const double* a, const double* b, size_t size) noexcept {
+    return table().f64.dot(a, b, size);
+}
+
+int32_t dot(const int32_t* a, const int32_t* b, size_t size) noexcept {
+    return table().i32.dot(a, b, size);
+}
+
+int64_t dot(const int64_t* a, const int64_t* b, size_t size) noexcept {
+    return table().i64.dot(a, b, size);
+}
+
+void add(float* out, const float* a, const float* b, size_t size) noexcept {
+    table().f32.add(out, a, b, size);
+}
+
+void add(double* out, const double* a, const double* b, size_t size)
+    noexcept {
+    table().f64.add(out, a, b, size);
+}
+
+void add(int32_t* out, const int32_t* a, const int32_t* b, size_t size)
+    noexcept {
+    table().i32.add(out, a, b, size);
+}
+
+void add(int64_t* out, const int64_t* a, const int64_t* b, size_t size)
+    noexcept {
+    table().i64.add(out, a, b, size);
+}
+
+void subtract(float* out, const float* a, const float* b, size_t size)
+    noexcept {
+    table().f32.subtract(out, a, b, size);
+}
+
+void subtract(double* out, const double* a, const double* b, size_t size)
+    noexcept {
+    table().f64.subtract(out, a, b, size);
+}
+
+void subtract(int32_t* out, const int32_t* a, const int32_t* b, size_t size)
+    noexcept {
+    table().i32.subtract(out, a, b, size);
+}
+
+void subtract(int64_t* out, const int64_t* a, const int64_t* b, size_t size)
+    noexcept {
+    table().i64.subtract(out, a, b, size);
+}
+
+void scale(float* out, const float* a, float scalar, size_t size) noexcept {
+    table().f32.scale(out, a, scalar, size);
+}
+
+void scale(double* out, const double* a, double scalar, size_t size)
+    noexcept {
+    table().f64.scale(out, a, scalar, size);
+}
+
+void scale(int32_t* out, const int32_t* a, int32_t scalar, size_t size)
+    noexcept {
+    table().i32.scale(out, a, scalar, size);
+}
+
+void scale(int64_t* out, const int64_t* a, int64_t scalar, size_t size)
+    noexcept {
+    table().i64.scale(out, a, scalar, size);
+}
+
+}  // namespace mvector_kernels
@@ -0,0 +1,63 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_MVECTOR_MVECTOR_KERNELS_H_
+#define LIBS_LIB_MVECTOR_MVECTOR_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Loops behind the MVector arithmetic for float, double, int32_t and
+// int64_t. Each kernel has SSE2, AVX2 and AVX-512 versions besides the
+// portable one; the first call picks the widest set that both the
+// processor and the build support. out may be the same array as a or b.
+//
+// The vector versions add the products of dot() in another order, so
+// float and double results may differ from a plain loop in the last bits.
+namespace mvector_kernels {
+
+enum Isa {
+    IsaScalar,
+    IsaSSE2,
+    IsaAVX2,
+    IsaAVX512
+};
+
+Isa detected_isa() noexcept;
+Isa active_isa() noexcept;
+// Switches every kernel to isa, or to detected_isa() if isa is wider.
+// Meant for tests and benchmarks.
+void use_isa(Isa isa) noexcept;
+
+float dot(const float* a, const float* b, size_t size) noexcept;
+double dot(const double* a, const double* b, size_t size) noexcept;
+int32_t dot(const int32_t* a, const int32_t* b, size_t size) noexcept;
+int64_t dot(const int64_t* a, const int64_t* b, size_t size) noexcept;
+
+void add(float* out, const float* a, const float* b, size_t size) noexcept;
+void add(double* out, const double* a, const double* b, size_t size)
+    noexcept;
+void add(int32_t* out, const int32_t* a, const int32_t* b, size_t size)
+    noexcept;
+void add(int64_t* out, const int64_t* a, const int64_t* b, size_t size)
+    noexcept;
+
+void subtract(float* out, const float* a, const float* b, size_t size)
+    noexcept;
+void subtract(double* out, const double* a, const double* b, size_t size)
+    noexcept;
+void subtract(int32_t* out, const int32_t* a, const int32_t* b, size_t size)
+    noexcept;
+void subtract(int64_t* out, const int64_t* a, const int64_t* b, size_t size)
+    noexcept;
+
+void scale(float* out, const float* a, float scalar, size_t size) noexcept;
+void scale(double* out, const double* a, double scalar, size_t size)
+    noexcept;
+void scale(int32_t* out, const int32_t* a, int32_t scalar, size_t size)
+    noexcept;
+void scale(int64_t* out, const int64_t* a, int64_t scalar, size_t size)
+    noexcept;
+
+}  // namespace mvector_kernels
+
+#endif  // LIBS_LIB_MVECTOR_MVECTOR_KERNELS_H_
@@ -0,0 +1,138 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_mvector/mvector_kernels_table.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace {
+
+struct F32 {
+    using value = float;
+    using reg = __m256;
+    static const size_t lanes = 8;
+
+    static inline reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static inline void store(float* p, reg r) { _mm256_storeu_ps(p, r); }
+    static inline reg set1(float x) { return _mm256_set1_ps(x); }
+    static inline reg zero() { return _mm256_setzero_ps(); }
+    static inline reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+
+    static inline float sum(reg r) {
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(r),
+            _mm256_extractf128_ps(r, 1));
+
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+        return _mm_cvtss_f32(half);
+    }
+};
+
+struct F64 {
+    using value = double;
+    using reg = __m256d;
+    static const size_t lanes = 4;
+
+    static inline reg load(const double* p) { return _mm256_loadu_pd(p); }
+    static inline void store(double* p, reg r) { _mm256_storeu_pd(p, r); }
+    static inline reg set1(double x) { return _mm256_set1_pd(x); }
+    static inline reg zero() { return _mm256_setzero_pd(); }
+    static inline reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+
+    static inline double sum(reg r) {
+        __m128d half = _mm_add_pd(_mm256_castpd256_pd128(r),
+            _mm256_extractf128_pd(r, 1));
+
+        return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+};
+
+struct I32 {
+    using value = int32_t;
+    using reg = __m256i;
+    static const size_t lanes = 8;
+
+    static inline reg load(const int32_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    static inline void store(int32_t* p, reg r) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r);
+    }
+
+    static inline reg set1(int32_t x) { return _mm256_set1_epi32(x); }
+    static inline reg zero() { return _mm256_setzero_si256(); }
+    static inline reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm256_sub_epi32(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm256_mullo_epi32(a, b); }
+
+    static inline int32_t sum(reg r) {
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(r),
+            _mm256_extracti128_si256(r, 1));
+
+        half = _mm_add_epi32(half,
+            _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_add_epi32(half,
+            _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(half);
+    }
+};
+
+// AVX2 still has no 64 bit multiply, see the SSE2 version.
+struct I64 {
+    using value = int64_t;
+    using reg = __m256i;
+    static const size_t lanes = 4;
+
+    static inline reg load(const int64_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    static inline void store(int64_t* p, reg r) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r);
+    }
+
+    static inline reg set1(int64_t x) { return _mm256_set1_epi64x(x); }
+    static inline reg zero() { return _mm256_setzero_si256(); }
+    static inline reg add(reg a, reg b) { return _mm256_add_epi64(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm256_sub_epi64(a, b); }
+
+    static inline reg mul(reg a, reg b) {
+        reg cross = _mm256_add_epi64(
+            _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+            _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+
+        return _mm256_add_epi64(_mm256_mul_epu32(a, b),
+            _mm256_slli_epi64(cross, 32));
+    }
+
+    static inline int64_t sum(reg r) {
+        int64_t lanes[4];
+
+        store(lanes, r);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+};
+
+}  // namespace
+
+bool mvector_kernels::detail::install_avx2(KernelTable* table) noexcept {
+    install<F32>(&table->f32);
+    install<F64>(&table->f64);
+    install<I32>(&table->i32);
+    install<I64>(&table->i64);
+
+    return true;
+}
+
+#else
+
+bool mvector_kernels::detail::install_avx2(KernelTable*) noexcept {
+    return false;
+}
+
+#endif
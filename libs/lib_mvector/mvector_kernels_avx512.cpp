@@ -0,0 +1,110 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_mvector/mvector_kernels_table.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace {
+
+struct F32 {
+    using value = float;
+    using reg = __m512;
+    static const size_t lanes = 16;
+
+    static inline reg load(const float* p) { return _mm512_loadu_ps(p); }
+    static inline void store(float* p, reg r) { _mm512_storeu_ps(p, r); }
+    static inline reg set1(float x) { return _mm512_set1_ps(x); }
+    static inline reg zero() { return _mm512_setzero_ps(); }
+    static inline reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+    static inline float sum(reg r) { return _mm512_reduce_add_ps(r); }
+};
+
+struct F64 {
+    using value = double;
+    using reg = __m512d;
+    static const size_t lanes = 8;
+
+    static inline reg load(const double* p) { return _mm512_loadu_pd(p); }
+    static inline void store(double* p, reg r) { _mm512_storeu_pd(p, r); }
+    static inline reg set1(double x) { return _mm512_set1_pd(x); }
+    static inline reg zero() { return _mm512_setzero_pd(); }
+    static inline reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+    static inline double sum(reg r) { return _mm512_reduce_add_pd(r); }
+};
+
+struct I32 {
+    using value = int32_t;
+    using reg = __m512i;
+    static const size_t lanes = 16;
+
+    static inline reg load(const int32_t* p) {
+        return _mm512_loadu_si512(p);
+    }
+
+    static inline void store(int32_t* p, reg r) {
+        _mm512_storeu_si512(p, r);
+    }
+
+    static inline reg set1(int32_t x) { return _mm512_set1_epi32(x); }
+    static inline reg zero() { return _mm512_setzero_si512(); }
+    static inline reg add(reg a, reg b) { return _mm512_add_epi32(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm512_sub_epi32(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm512_mullo_epi32(a, b); }
+    static inline int32_t sum(reg r) { return _mm512_reduce_add_epi32(r); }
+};
+
+// The 64 bit multiply is AVX-512DQ, only F is required here, see the SSE2
+// version for the product.
+struct I64 {
+    using value = int64_t;
+    using reg = __m512i;
+    static const size_t lanes = 8;
+
+    static inline reg load(const int64_t* p) {
+        return _mm512_loadu_si512(p);
+    }
+
+    static inline void store(int64_t* p, reg r) {
+        _mm512_storeu_si512(p, r);
+    }
+
+    static inline reg set1(int64_t x) { return _mm512_set1_epi64(x); }
+    static inline reg zero() { return _mm512_setzero_si512(); }
+    static inline reg add(reg a, reg b) { return _mm512_add_epi64(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm512_sub_epi64(a, b); }
+
+    static inline reg mul(reg a, reg b) {
+        reg cross = _mm512_add_epi64(
+            _mm512_mul_epu32(_mm512_srli_epi64(a, 32), b),
+            _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)));
+
+        return _mm512_add_epi64(_mm512_mul_epu32(a, b),
+            _mm512_slli_epi64(cross, 32));
+    }
+
+    static inline int64_t sum(reg r) { return _mm512_reduce_add_epi64(r); }
+};
+
+}  // namespace
+
+bool mvector_kernels::detail::install_avx512(KernelTable* table) noexcept {
+    install<F32>(&table->f32);
+    install<F64>(&table->f64);
+    install<I32>(&table->i32);
+    install<I64>(&table->i64);
+
+    return true;
+}
+
+#else
+
+bool mvector_kernels::detail::install_avx512(KernelTable*) noexcept {
+    return false;
+}
+
+#endif
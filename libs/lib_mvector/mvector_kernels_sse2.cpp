@@ -0,0 +1,139 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_mvector/mvector_kernels_table.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+
+namespace {
+
+struct F32 {
+    using value = float;
+    using reg = __m128;
+    static const size_t lanes = 4;
+
+    static inline reg load(const float* p) { return _mm_loadu_ps(p); }
+    static inline void store(float* p, reg r) { _mm_storeu_ps(p, r); }
+    static inline reg set1(float x) { return _mm_set1_ps(x); }
+    static inline reg zero() { return _mm_setzero_ps(); }
+    static inline reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+
+    static inline float sum(reg r) {
+        r = _mm_add_ps(r, _mm_movehl_ps(r, r));
+        r = _mm_add_ss(r, _mm_shuffle_ps(r, r, 1));
+        return _mm_cvtss_f32(r);
+    }
+};
+
+struct F64 {
+    using value = double;
+    using reg = __m128d;
+    static const size_t lanes = 2;
+
+    static inline reg load(const double* p) { return _mm_loadu_pd(p); }
+    static inline void store(double* p, reg r) { _mm_storeu_pd(p, r); }
+    static inline reg set1(double x) { return _mm_set1_pd(x); }
+    static inline reg zero() { return _mm_setzero_pd(); }
+    static inline reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+
+    static inline double sum(reg r) {
+        return _mm_cvtsd_f64(_mm_add_sd(r, _mm_unpackhi_pd(r, r)));
+    }
+};
+
+// SSE2 has no full 32 or 64 bit multiply, the products are put together
+// from the 32 x 32 -> 64 bit one. The low bits do not depend on the sign.
+struct I32 {
+    using value = int32_t;
+    using reg = __m128i;
+    static const size_t lanes = 4;
+
+    static inline reg load(const int32_t* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    static inline void store(int32_t* p, reg r) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r);
+    }
+
+    static inline reg set1(int32_t x) { return _mm_set1_epi32(x); }
+    static inline reg zero() { return _mm_setzero_si128(); }
+    static inline reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm_sub_epi32(a, b); }
+
+    static inline reg mul(reg a, reg b) {
+        reg even = _mm_mul_epu32(a, b);
+        reg odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+
+        return _mm_unpacklo_epi32(
+            _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    static inline int32_t sum(reg r) {
+        r = _mm_add_epi32(r, _mm_shuffle_epi32(r, _MM_SHUFFLE(1, 0, 3, 2)));
+        r = _mm_add_epi32(r, _mm_shuffle_epi32(r, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(r);
+    }
+};
+
+struct I64 {
+    using value = int64_t;
+    using reg = __m128i;
+    static const size_t lanes = 2;
+
+    static inline reg load(const int64_t* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    static inline void store(int64_t* p, reg r) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r);
+    }
+
+    static inline reg set1(int64_t x) {
+        return _mm_set_epi32(static_cast<int>(x >> 32), static_cast<int>(x),
+            static_cast<int>(x >> 32), static_cast<int>(x));
+    }
+
+    static inline reg zero() { return _mm_setzero_si128(); }
+    static inline reg add(reg a, reg b) { return _mm_add_epi64(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm_sub_epi64(a, b); }
+
+    static inline reg mul(reg a, reg b) {
+        reg cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+            _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+
+        return _mm_add_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(cross, 32));
+    }
+
+    static inline int64_t sum(reg r) {
+        int64_t lanes[2];
+
+        store(lanes, r);
+        return lanes[0] + lanes[1];
+    }
+};
+
+}  // namespace
+
+bool mvector_kernels::detail::install_sse2(KernelTable* table) noexcept {
+    install<F32>(&table->f32);
+    install<F64>(&table->f64);
+    install<I32>(&table->i32);
+    install<I64>(&table->i64);
+
+    return true;
+}
+
+#else
+
+bool mvector_kernels::detail::install_sse2(KernelTable*) noexcept {
+    return false;
+}
+
+#endif
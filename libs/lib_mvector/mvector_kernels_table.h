@@ -0,0 +1,120 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_MVECTOR_MVECTOR_KERNELS_TABLE_H_
+#define LIBS_LIB_MVECTOR_MVECTOR_KERNELS_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Internal to the kernels: the table of implementations in use and the
+// loops shared by the instruction set specific files. Every such file is
+// compiled with its own target flags, so the loops are templates over a
+// type local to that file and nothing else inline is used there, otherwise
+// the linker could hand an AVX-512 copy of a function to the portable code.
+namespace mvector_kernels {
+namespace detail {
+
+template<typename T>
+struct Kernels {
+    T (*dot)(const T*, const T*, size_t);
+    void (*add)(T*, const T*, const T*, size_t);
+    void (*subtract)(T*, const T*, const T*, size_t);
+    void (*scale)(T*, const T*, T, size_t);
+};
+
+struct KernelTable {
+    Kernels<float> f32;
+    Kernels<double> f64;
+    Kernels<int32_t> i32;
+    Kernels<int64_t> i64;
+};
+
+// Overwrite the kernels with the versions for one instruction set. They
+// return false and leave the table alone when the build cannot target it.
+bool install_sse2(KernelTable* table) noexcept;
+bool install_avx2(KernelTable* table) noexcept;
+bool install_avx512(KernelTable* table) noexcept;
+
+// V describes one register: value, reg, lanes and the static functions
+// load, store, set1, zero, add, sub, mul and sum (of the lanes).
+template<class V>
+typename V::value dot(const typename V::value* a,
+    const typename V::value* b, size_t size) {
+    typename V::reg first = V::zero();
+    typename V::reg second = V::zero();
+    size_t i = 0;
+
+    for (; i + 2 * V::lanes <= size; i += 2 * V::lanes) {
+        first = V::add(first, V::mul(V::load(a + i), V::load(b + i)));
+        second = V::add(second, V::mul(V::load(a + i + V::lanes),
+            V::load(b + i + V::lanes)));
+    }
+
+    for (; i + V::lanes <= size; i += V::lanes) {
+        first = V::add(first, V::mul(V::load(a + i), V::load(b + i)));
+    }
+
+    typename V::value result = V::sum(V::add(first, second));
+
+    for (; i < size; i++) {
+        result = result + a[i] * b[i];
+    }
+
+    return result;
+}
+
+template<class V>
+void add(typename V::value* out, const typename V::value* a,
+    const typename V::value* b, size_t size) {
+    size_t i = 0;
+
+    for (; i + V::lanes <= size; i += V::lanes) {
+        V::store(out + i, V::add(V::load(a + i), V::load(b + i)));
+    }
+
+    for (; i < size; i++) {
+        out[i] = a[i] + b[i];
+    }
+}
+
+template<class V>
+void subtract(typename V::value* out, const typename V::value* a,
+    const typename V::value* b, size_t size) {
+    size_t i = 0;
+
+    for (; i + V::lanes <= size; i += V::lanes) {
+        V::store(out + i, V::sub(V::load(a + i), V::load(b + i)));
+    }
+
+    for (; i < size; i++) {
+        out[i] = a[i] - b[i];
+    }
+}
+
+template<class V>
+void scale(typename V::value* out, const typename V::value* a,
+    typename V::value scalar, size_t size) {
+    typename V::reg factor = V::set1(scalar);
+    size_t i = 0;
+
+    for (; i + V::lanes <= size; i += V::lanes) {
+        V::store(out + i, V::mul(V::load(a + i), factor));
+    }
+
+    for (; i < size; i++) {
+        out[i] = a[i] * scalar;
+    }
+}
+
+template<class V>
+void install(Kernels<typename V::value>* kernels) {
+    kernels->dot = &dot<V>;
+    kernels->add = &add<V>;
+    kernels->subtract = &subtract<V>;
+    kernels->scale = &scale<V>;
+}
+
+}  // namespace detail
+}  // namespace mvector_kernels
+
+#endif  // LIBS_LIB_MVECTOR_MVECTOR_KERNELS_TABLE_H_
@@ -0,0 +1,3 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_parallel_algorithms/parallel_algorithms.h"
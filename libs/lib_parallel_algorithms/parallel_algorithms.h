@@ -0,0 +1,470 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_PARALLEL_ALGORITHMS_PARALLEL_ALGORITHMS_H_
+#define LIBS_LIB_PARALLEL_ALGORITHMS_PARALLEL_ALGORITHMS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include "libs/lib_mvector/mvector.h"
+#include "libs/lib_parallel_algorithms/thread_pool.h"
+#include "libs/lib_tvector/tvector.h"
+
+// Parallel versions of the common sequence algorithms for TVector and
+// MVector. The container is cut into chunks of slots, Deleted slots are
+// skipped inside each chunk, so the algorithms see exactly the elements an
+// iterator would, in the same order:
+//
+//     double sum = parallel_reduce(vec, 0.0,
+//         [](double a, double b) { return a + b; });
+//
+// reduce and the scans regroup the operation, op has to be associative.
+// The functions may be called concurrently on one container as long as
+// nobody modifies it; the output container must be another object than
+// the input and its element type default constructible.
+
+enum Schedule {
+    // One chunk per thread of the pool, cheapest when every element costs
+    // the same.
+    StaticSchedule,
+    // Chunks of grain slots taken by whichever thread is free, for uneven
+    // work per element.
+    DynamicSchedule
+};
+
+struct ParallelPolicy {
+    Schedule schedule;
+    // Minimal chunk for StaticSchedule, the chunk for DynamicSchedule,
+    // 0 picks one from the size of the container.
+    size_t grain;
+    // nullptr runs on default_thread_pool().
+    ThreadPool* pool;
+
+    ParallelPolicy(Schedule schedule = StaticSchedule, size_t grain = 0,
+        ThreadPool* pool = nullptr) noexcept : schedule(schedule),
+        grain(grain), pool(pool) {}
+};
+
+namespace parallel_detail {
+
+const size_t default_grain = 1024;
+const size_t chunks_per_thread = 8;
+
+// Elements of a container as slots data[0, count), the Deleted ones
+// among them are known to vec; vec is nullptr when there are none.
+template<typename T>
+struct Slots {
+    using value_type = typename std::remove_const<T>::type;
+
+    T* data;
+    const TVector<value_type>* vec;
+    size_t count;
+
+    inline size_t next_live(size_t slot) const noexcept {
+        return vec != nullptr ? vec->next_live(slot) : slot;
+    }
+
+    inline size_t count_live(size_t first, size_t last) const noexcept {
+        return vec != nullptr ? vec->count_live(first, last) : last - first;
+    }
+
+    // Calls f(slot) for the live slots in [first, last).
+    template<class Function>
+    inline void for_live(size_t first, size_t last, Function&& f) const {
+        if (vec == nullptr) {
+            for (size_t slot = first; slot < last; slot++) {
+                f(slot);
+            }
+
+            return;
+        }
+
+        for (size_t slot = vec->next_live(first); slot < last;
+            slot = vec->next_live(slot + 1)) {
+            f(slot);
+        }
+    }
+};
+
+template<typename T>
+inline Slots<T> slots(TVector<T>& vec) noexcept {
+    return { vec.data(), vec.is_dense() ? nullptr : &vec, vec.slot_count() };
+}
+
+template<typename T>
+inline Slots<const T> slots(const TVector<T>& vec) noexcept {
+    return { vec.data(), vec.is_dense() ? nullptr : &vec, vec.slot_count() };
+}
+
+template<typename T>
+inline Slots<T> slots(MVector<T>& vec) noexcept {
+    return { vec.data(), nullptr, vec.size() };
+}
+
+template<typename T>
+inline Slots<const T> slots(const MVector<T>& vec) noexcept {
+    return { vec.data(), nullptr, vec.size() };
+}
+
+// Makes out hold size dense elements and returns their storage.
+template<typename T>
+T* prepare_output(TVector<T>& out, size_t size) {
+    out.resize(size);
+
+    return out.data();
+}
+
+template<typename T>
+T* prepare_output(MVector<T>& out, size_t size) {
+    if (out.size() != size)
+        out = MVector<T>(static_cast<int>(size), out.resource());
+
+    return out.data();
+}
+
+// Fixed split of [0, total) slots, chunk i is [first(i), last(i)).
+struct Chunks {
+    size_t total;
+    size_t size;
+    size_t count;
+
+    inline size_t first(size_t chunk) const noexcept {
+        return chunk * size;
+    }
+
+    inline size_t last(size_t chunk) const noexcept {
+        return std::min(total, (chunk + 1) * size);
+    }
+};
+
+inline ThreadPool& pool_of(const ParallelPolicy& policy) {
+    return policy.pool != nullptr ? *policy.pool : default_thread_pool();
+}
+
+inline Chunks make_chunks(size_t total, const ParallelPolicy& policy) {
+    size_t threads = pool_of(policy).concurrency();
+    size_t size;
+
+    if (policy.schedule == StaticSchedule) {
+        size_t grain = policy.grain != 0 ? policy.grain : default_grain;
+        size = std::max(grain, (total + threads - 1) / threads);
+    } else if (policy.grain != 0) {
+        size = policy.grain;
+    } else {
+        size = std::max(default_grain,
+            total / (threads * chunks_per_thread) + 1);
+    }
+
+    return { total, size, total == 0 ? 0 : (total + size - 1) / size };
+}
+
+// Calls f(chunk, first, last) once for every chunk.
+template<class Function>
+void for_chunks(const Chunks& chunks, const ParallelPolicy& policy,
+    Function&& f) {
+    if (chunks.count == 1) {
+        f(0, chunks.first(0), chunks.last(0));
+        return;
+    }
+
+    ThreadPool& pool = pool_of(policy);
+
+    if (policy.schedule == StaticSchedule) {
+        pool.run(chunks.count, [&chunks, &f](size_t chunk) {
+            f(chunk, chunks.first(chunk), chunks.last(chunk));
+        });
+
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+
+    pool.run(std::min(pool.concurrency(), chunks.count),
+        [&chunks, &f, &next](size_t) {
+        for (size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+            chunk < chunks.count;
+            chunk = next.fetch_add(1, std::memory_order_relaxed)) {
+            f(chunk, chunks.first(chunk), chunks.last(chunk));
+        }
+    });
+}
+
+// Position of the first element of every chunk in the output,
+// offsets[chunks.count] is the total.
+template<typename T>
+TVector<size_t> live_offsets(const Slots<T>& in, const Chunks& chunks,
+    const ParallelPolicy& policy) {
+    TVector<size_t> offsets(chunks.count + 1);
+    size_t* counts = offsets.data();
+
+    if (in.vec == nullptr) {
+        for (size_t chunk = 0; chunk <= chunks.count; chunk++) {
+            counts[chunk] = std::min(in.count, chunks.first(chunk));
+        }
+
+        return offsets;
+    }
+
+    for_chunks(chunks, policy, [&in, counts](size_t chunk, size_t first,
+        size_t last) {
+        counts[chunk + 1] = in.count_live(first, last);
+    });
+
+    counts[0] = 0;
+
+    for (size_t chunk = 1; chunk <= chunks.count; chunk++) {
+        counts[chunk] += counts[chunk - 1];
+    }
+
+    return offsets;
+}
+
+// Combines each chunk of in with op into partials; has[chunk] is false for
+// chunks without live elements.
+template<typename T, typename U, class BinaryOperation>
+void reduce_chunks(const Slots<T>& in, const Chunks& chunks,
+    const ParallelPolicy& policy, BinaryOperation& op, U* partials,
+    bool* has) {
+    for_chunks(chunks, policy, [&in, &op, partials, has](size_t chunk,
+        size_t first, size_t last) {
+        bool started = false;
+
+        in.for_live(first, last, [&](size_t slot) {
+            if (started) {
+                partials[chunk] = op(partials[chunk], in.data[slot]);
+            } else {
+                partials[chunk] = in.data[slot];
+                started = true;
+            }
+        });
+
+        has[chunk] = started;
+    });
+}
+
+}  // namespace parallel_detail
+
+// Calls f on every element, in no particular order across chunks.
+template<class Container, class Function>
+void parallel_for_each(Container& container, Function f,
+    const ParallelPolicy& policy = ParallelPolicy()) {
+    auto in = parallel_detail::slots(container);
+    parallel_detail::Chunks chunks = parallel_detail::make_chunks(in.count,
+        policy);
+
+    parallel_detail::for_chunks(chunks, policy, [&in, &f](size_t,
+        size_t first, size_t last) {
+        in.for_live(first, last, [&](size_t slot) { f(in.data[slot]); });
+    });
+}
+
+// out[i] = f(in[i]) for every element of in; out is resized to in.size().
+template<class Input, class Output, class Function>
+void parallel_transform(const Input& input, Output& output, Function f,
+    const ParallelPolicy& policy = ParallelPolicy()) {
+    auto in = parallel_detail::slots(input);
+    parallel_detail::Chunks chunks = parallel_detail::make_chunks(in.count,
+        policy);
+    TVector<size_t> offsets = parallel_detail::live_offsets(in, chunks,
+        policy);
+    const size_t* starts = offsets.data();
+    auto out = parallel_detail::prepare_output(output, starts[chunks.count]);
+
+    parallel_detail::for_chunks(chunks, policy, [&in, &f, starts, out](
+        size_t chunk, size_t first, size_t last) {
+        size_t index = starts[chunk];
+
+        in.for_live(first, last, [&](size_t slot) {
+            out[index++] = f(in.data[slot]);
+        });
+    });
+}
+
+// init combined with every element by op; the grouping is unspecified.
+template<class Container, typename T, class BinaryOperation>
+T parallel_reduce(const Container& container, T init, BinaryOperation op,
+    const ParallelPolicy& policy = ParallelPolicy()) {
+    auto in = parallel_detail::slots(container);
+    parallel_detail::Chunks chunks = parallel_detail::make_chunks(in.count,
+        policy);
+    TVector<T> partials(chunks.count);
+    TVector<bool> has(chunks.count);
+
+    parallel_detail::reduce_chunks(in, chunks, policy, op, partials.data(),
+        has.data());
+
+    for (size_t chunk = 0; chunk < chunks.count; chunk++) {
+        if (has.data()[chunk])
+            init = op(init, partials.data()[chunk]);
+    }
+
+    return init;
+}
+
+template<class Container, class Predicate>
+size_t parallel_count_if(const Container& container, Predicate pred,
+    const ParallelPolicy& policy = ParallelPolicy()) {
+    auto in = parallel_detail::slots(container);
+    parallel_detail::Chunks chunks = parallel_detail::make_chunks(in.count,
+        policy);
+    TVector<size_t> counts(chunks.count);
+    size_t* partials = counts.data();
+
+    parallel_detail::for_chunks(chunks, policy, [&in, &pred, partials](
+        size_t chunk, size_t first, size_t last) {
+        size_t count = 0;
+
+        in.for_live(first, last, [&](size_t slot) {
+            if (pred(in.data[slot]))
+                count++;
+        });
+
+        partials[chunk] = count;
+    });
+
+    size_t total = 0;
+
+    for (size_t chunk = 0; chunk < chunks.count; chunk++) {
+        total += partials[chunk];
+    }
+
+    return total;
+}
+
+// out[i] = in[0] op ... op in[i]. Two passes: the chunk totals, then every
+// chunk scans again starting from the total of the chunks before it.
+template<class Input, class Output, class BinaryOperation>
+void parallel_inclusive_scan(const Input& input, Output& output,
+    BinaryOperation op, const ParallelPolicy& policy = ParallelPolicy()) {
+    auto in = parallel_detail::slots(input);
+    using T = typename decltype(in)::value_type;
+    parallel_detail::Chunks chunks = parallel_detail::make_chunks(in.count,
+        policy);
+    TVector<size_t> offsets = parallel_detail::live_offsets(in, chunks,
+        policy);
+    const size_t* starts = offsets.data();
+    auto out = parallel_detail::prepare_output(output, starts[chunks.count]);
+    TVector<T> carries(chunks.count);
+    TVector<bool> has(chunks.count);
+    T* carry = carries.data();
+    bool* has_carry = has.data();
+
+    parallel_detail::reduce_chunks(in, chunks, policy, op, carry, has_carry);
+
+    // Turns the chunk totals into the prefix before every chunk.
+    T running = T();
+    bool started = false;
+
+    for (size_t chunk = 0; chunk < chunks.count; chunk++) {
+        bool present = has_carry[chunk];
+        T total = std::move(carry[chunk]);
+
+        has_carry[chunk] = started;
+
+        if (started)
+            carry[chunk] = running;
+
+        if (present) {
+            running = started ? op(running, total) : std::move(total);
+            started = true;
+        }
+    }
+
+    parallel_detail::for_chunks(chunks, policy, [&in, &op, starts, out,
+        carry, has_carry](size_t chunk, size_t first, size_t last) {
+        size_t index = starts[chunk];
+        bool started = has_carry[chunk];
+        T acc = started ? carry[chunk] : T();
+
+        in.for_live(first, last, [&](size_t slot) {
+            acc = started ? op(acc, in.data[slot]) : in.data[slot];
+            started = true;
+            out[index++] = acc;
+        });
+    });
+}
+
+// out[i] = init op in[0] op ... op in[i - 1].
+template<class Input, class Output, typename T, class BinaryOperation>
+void parallel_exclusive_scan(const Input& input, Output& output, T init,
+    BinaryOperation op, const ParallelPolicy& policy = ParallelPolicy()) {
+    auto in = parallel_detail::slots(input);
+    parallel_detail::Chunks chunks = parallel_detail::make_chunks(in.count,
+        policy);
+    TVector<size_t> offsets = parallel_detail::live_offsets(in, chunks,
+        policy);
+    const size_t* starts = offsets.data();
+    auto out = parallel_detail::prepare_output(output, starts[chunks.count]);
+    TVector<T> carries(chunks.count);
+    TVector<bool> has(chunks.count);
+    T* carry = carries.data();
+
+    parallel_detail::reduce_chunks(in, chunks, policy, op, carry, has.data());
+
+    for (size_t chunk = 0; chunk < chunks.count; chunk++) {
+        T next = has.data()[chunk] ? op(init, carry[chunk]) : init;
+
+        carry[chunk] = std::move(init);
+        init = std::move(next);
+    }
+
+    parallel_detail::for_chunks(chunks, policy, [&in, &op, starts, out,
+        carry](size_t chunk, size_t first, size_t last) {
+        size_t index = starts[chunk];
+        T acc = carry[chunk];
+
+        in.for_live(first, last, [&](size_t slot) {
+            out[index++] = acc;
+            acc = op(acc, in.data[slot]);
+        });
+    });
+}
+
+// Copies the elements that satisfy pred to out, keeping their order; out
+// ends up with exactly those elements. pred is called once per element.
+template<class Input, class Output, class Predicate>
+void parallel_copy_if(const Input& input, Output& output, Predicate pred,
+    const ParallelPolicy& policy = ParallelPolicy()) {
+    auto in = parallel_detail::slots(input);
+    parallel_detail::Chunks chunks = parallel_detail::make_chunks(in.count,
+        policy);
+    TVector<bool> selected(in.count);
+    TVector<size_t> offsets(chunks.count + 1);
+    bool* keep = selected.data();
+    size_t* starts = offsets.data();
+
+    parallel_detail::for_chunks(chunks, policy, [&in, &pred, keep, starts](
+        size_t chunk, size_t first, size_t last) {
+        size_t count = 0;
+
+        in.for_live(first, last, [&](size_t slot) {
+            keep[slot] = pred(in.data[slot]);
+
+            if (keep[slot])
+                count++;
+        });
+
+        starts[chunk + 1] = count;
+    });
+
+    starts[0] = 0;
+
+    for (size_t chunk = 1; chunk <= chunks.count; chunk++) {
+        starts[chunk] += starts[chunk - 1];
+    }
+
+    auto out = parallel_detail::prepare_output(output, starts[chunks.count]);
+
+    parallel_detail::for_chunks(chunks, policy, [&in, keep, starts, out](
+        size_t chunk, size_t first, size_t last) {
+        size_t index = starts[chunk];
+
+        in.for_live(first, last, [&](size_t slot) {
+            if (keep[slot])
+                out[index++] = in.data[slot];
+        });
+    });
+}
+
+#endif  // LIBS_LIB_PARALLEL_ALGORITHMS_PARALLEL_ALGORITHMS_H_
@@ -0,0 +1,139 @@
+// Copyright 2026 Chernykh Valentin
+
+#include "libs/lib_parallel_algorithms/thread_pool.h"
+
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace {
+thread_local bool inside_task = false;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threads) : _threads(nullptr), _thread_count(0),
+    _task(nullptr), _next(0), _total(0), _pending(0), _generation(0),
+    _stop(false) {
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+
+    if (threads > 1) {
+        _threads = new std::thread[threads - 1];
+
+        for (; _thread_count < threads - 1; _thread_count++) {
+            _threads[_thread_count] = std::thread(&ThreadPool::work, this);
+        }
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+
+    _wake.notify_all();
+
+    for (size_t i = 0; i < _thread_count; i++) {
+        _threads[i].join();
+    }
+
+    delete[] _threads;
+}
+
+size_t ThreadPool::concurrency() const noexcept {
+    return _thread_count + 1;
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0)
+        return;
+
+    if (inside_task || _thread_count == 0 || count == 1) {
+        for (size_t i = 0; i < count; i++) {
+            task(i);
+        }
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(_run_mutex);
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _task = &task;
+    _next = 0;
+    _total = count;
+    _pending = count;
+    _error = nullptr;
+    uint64_t generation = ++_generation;
+
+    _wake.notify_all();
+
+    while (run_next(lock, generation)) {}
+
+    _done.wait(lock, [this]() { return _pending == 0; });
+    _task = nullptr;
+
+    std::exception_ptr error = _error;
+    _error = nullptr;
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void ThreadPool::work() noexcept {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        _wake.wait(lock, [this, seen]() {
+            return _stop || _generation != seen;
+        });
+
+        if (_stop)
+            return;
+
+        seen = _generation;
+
+        while (run_next(lock, seen)) {}
+    }
+}
+
+// Runs one task of the batch started as generation, false once the batch
+// has no tasks left to hand out. Called and returns with lock held.
+bool ThreadPool::run_next(std::unique_lock<std::mutex>& lock,
+    uint64_t generation) noexcept {
+    if (_generation != generation || _next >= _total)
+        return false;
+
+    size_t index = _next++;
+    const std::function<void(size_t)>* task = _task;
+
+    lock.unlock();
+    inside_task = true;
+
+    std::exception_ptr error;
+
+    try {
+        (*task)(index);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    inside_task = false;
+    lock.lock();
+
+    if (error && !_error)
+        _error = error;
+
+    if (--_pending == 0)
+        _done.notify_all();
+
+    return true;
+}
+
+ThreadPool& default_thread_pool() {
+    static ThreadPool pool;
+
+    return pool;
+}
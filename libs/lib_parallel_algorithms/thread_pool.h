@@ -0,0 +1,58 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_PARALLEL_ALGORITHMS_THREAD_POOL_H_
+#define LIBS_LIB_PARALLEL_ALGORITHMS_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Fixed set of worker threads that run batches of indexed tasks. run()
+// hands out the indices one by one, the calling thread works on them too,
+// and returns once every task is done. Calls from different threads are
+// served one after another; a run() from inside a task executes its batch
+// on the calling thread, so nesting does not deadlock.
+class ThreadPool {
+ private:
+    std::thread* _threads;
+    size_t _thread_count;
+
+    std::mutex _run_mutex;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    const std::function<void(size_t)>* _task;
+    size_t _next;
+    size_t _total;
+    size_t _pending;
+    uint64_t _generation;
+    bool _stop;
+    std::exception_ptr _error;
+
+ public:
+    // threads is the total concurrency including the caller, 0 picks
+    // std::thread::hardware_concurrency().
+    explicit ThreadPool(size_t threads = 0);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool() noexcept;
+
+    size_t concurrency() const noexcept;
+
+    // Calls task(i) for every i in [0, count). The first exception thrown
+    // by a task is rethrown here after the others have finished.
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+ private:
+    void work() noexcept;
+    bool run_next(std::unique_lock<std::mutex>& lock, uint64_t generation)
+        noexcept;
+};
+
+// Pool shared by the parallel algorithms unless they are given another one.
+ThreadPool& default_thread_pool();
+
+#endif  // LIBS_LIB_PARALLEL_ALGORITHMS_THREAD_POOL_H_
@@ -0,0 +1,400 @@
+// Copyright 2026 Chernykh Valentin
+
+#ifndef LIBS_LIB_SMALL_MVECTOR_SMALL_MVECTOR_H_
+#define LIBS_LIB_SMALL_MVECTOR_SMALL_MVECTOR_H_
+
+#include <cmath>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "libs/lib_memory_resource/memory_resource.h"
+#include "libs/lib_mvector/mvector.h"
+
+// MVector that keeps up to N elements inside the object and only takes
+// memory from the default resource for longer vectors.
+template<typename T, size_t N>
+class SmallMVector {
+    static_assert(N > 0, "SmallMVector: inline capacity must be positive");
+
+ private:
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type _inline;
+    T* _data;
+    size_t _size;
+    MemoryResource* _resource;
+
+ public:
+    SmallMVector();
+    explicit SmallMVector(int);
+    SmallMVector(std::initializer_list<T> init);
+    explicit SmallMVector(const MVector<T>&);
+    SmallMVector(const SmallMVector&);
+    SmallMVector(SmallMVector&&) noexcept;
+    ~SmallMVector() noexcept;
+
+    operator MVector<T>() const;
+
+    SmallMVector<T, N>& operator=(const SmallMVector<T, N>&);
+    SmallMVector<T, N>& operator=(SmallMVector<T, N>&&) noexcept;
+    SmallMVector<T, N> operator+(const SmallMVector<T, N>&) const;
+    SmallMVector<T, N> operator-(const SmallMVector<T, N>&) const;
+    T operator*(const SmallMVector<T, N>&) const;
+    SmallMVector<T, N> operator*(T scalar) const;
+    SmallMVector<T, N> operator/(T scalar) const;
+    T& operator[](size_t index);
+    const T& operator[](size_t index) const;
+
+    SmallMVector<T, N>& operator+=(const SmallMVector<T, N>&);
+    SmallMVector<T, N>& operator-=(const SmallMVector<T, N>&);
+    SmallMVector<T, N>& operator*=(T scalar);
+    SmallMVector<T, N>& operator/=(T scalar);
+
+    bool operator==(const SmallMVector<T, N>& other) const;
+    bool operator!=(const SmallMVector<T, N>& other) const;
+
+    T length() const;
+    SmallMVector<T, N> normalized() const;
+
+    size_t size() const;
+    bool is_inline() const noexcept;
+    static size_t inline_capacity() noexcept;
+
+ private:
+    T* inline_data() noexcept;
+    void allocate(size_t size);
+    void release() noexcept;
+};
+
+template<typename T, size_t N>
+SmallMVector<T, N>::SmallMVector() : _data(inline_data()), _size(0),
+_resource(get_default_resource()) {}
+
+template<typename T, size_t N>
+SmallMVector<T, N>::SmallMVector(int size) : SmallMVector() {
+    if (size < 0) {
+        throw std::invalid_argument("SmallMVector: size must be non-negative");
+    }
+
+    allocate(size);
+
+    for (; _size < static_cast<size_t>(size); _size++) {
+        ::new (static_cast<void*>(_data + _size)) T();
+    }
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>::SmallMVector(std::initializer_list<T> init) :
+    SmallMVector() {
+    allocate(init.size());
+
+    for (const T& elem : init) {
+        ::new (static_cast<void*>(_data + _size)) T(elem);
+        _size++;
+    }
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>::SmallMVector(const MVector<T>& other) : SmallMVector() {
+    allocate(other.size());
+
+    for (; _size < other.size(); _size++) {
+        ::new (static_cast<void*>(_data + _size)) T(other.data()[_size]);
+    }
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>::SmallMVector(const SmallMVector& other) : SmallMVector() {
+    allocate(other._size);
+
+    for (; _size < other._size; _size++) {
+        ::new (static_cast<void*>(_data + _size)) T(other._data[_size]);
+    }
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>::SmallMVector(SmallMVector&& other) noexcept :
+    _data(inline_data()), _size(0), _resource(other._resource) {
+    if (!other.is_inline()) {
+        _data = other._data;
+        _size = other._size;
+        other._data = other.inline_data();
+        other._size = 0;
+        return;
+    }
+
+    for (; _size < other._size; _size++) {
+        ::new (static_cast<void*>(_data + _size))
+            T(std::move(other._data[_size]));
+    }
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>::~SmallMVector() noexcept {
+    release();
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>::operator MVector<T>() const {
+    MVector<T> result(static_cast<int>(_size));
+
+    for (size_t i = 0; i < _size; i++) {
+        result.data()[i] = _data[i];
+    }
+
+    return result;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>& SmallMVector<T, N>::operator=(const SmallMVector& other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    if (_size == other._size) {
+        for (size_t i = 0; i < _size; i++) {
+            _data[i] = other._data[i];
+        }
+
+        return *this;
+    }
+
+    release();
+    allocate(other._size);
+
+    for (; _size < other._size; _size++) {
+        ::new (static_cast<void*>(_data + _size)) T(other._data[_size]);
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>& SmallMVector<T, N>::operator=(SmallMVector&& other)
+noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    release();
+
+    if (!other.is_inline() && _resource == other._resource) {
+        _data = other._data;
+        _size = other._size;
+        other._data = other.inline_data();
+        other._size = 0;
+        return *this;
+    }
+
+    allocate(other._size);
+
+    for (; _size < other._size; _size++) {
+        ::new (static_cast<void*>(_data + _size))
+            T(std::move(other._data[_size]));
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N> SmallMVector<T, N>::operator+(const SmallMVector& other)
+const {
+    SmallMVector<T, N> result(*this);
+
+    result += other;
+
+    return result;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N> SmallMVector<T, N>::operator-(const SmallMVector& other)
+const {
+    SmallMVector<T, N> result(*this);
+
+    result -= other;
+
+    return result;
+}
+
+template<typename T, size_t N>
+T SmallMVector<T, N>::operator*(const SmallMVector& other) const {
+    if (_size != other._size) {
+        throw std::invalid_argument("SmallMVector: size mismatch");
+    }
+
+    T result{};
+
+    for (size_t i = 0; i < _size; i++) {
+        result = result + _data[i] * other._data[i];
+    }
+
+    return result;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N> SmallMVector<T, N>::operator*(T scalar) const {
+    SmallMVector<T, N> result(*this);
+
+    result *= scalar;
+
+    return result;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N> SmallMVector<T, N>::operator/(T scalar) const {
+    SmallMVector<T, N> result(*this);
+
+    result /= scalar;
+
+    return result;
+}
+
+template<typename T, size_t N>
+T& SmallMVector<T, N>::operator[](size_t index) {
+    if (index >= _size) {
+        throw std::out_of_range("SmallMVector operator[]: Index out of range.");
+    }
+
+    return _data[index];
+}
+
+template<typename T, size_t N>
+const T& SmallMVector<T, N>::operator[](size_t index) const {
+    if (index >= _size) {
+        throw std::out_of_range("SmallMVector operator[]: Index out of range.");
+    }
+
+    return _data[index];
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>& SmallMVector<T, N>::operator+=(const SmallMVector& other) {
+    if (_size != other._size) {
+        throw std::invalid_argument("SmallMVector: size mismatch");
+    }
+
+    for (size_t i = 0; i < _size; i++) {
+        _data[i] = _data[i] + other._data[i];
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>& SmallMVector<T, N>::operator-=(const SmallMVector& other) {
+    if (_size != other._size) {
+        throw std::invalid_argument("SmallMVector: size mismatch");
+    }
+
+    for (size_t i = 0; i < _size; i++) {
+        _data[i] = _data[i] - other._data[i];
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>& SmallMVector<T, N>::operator*=(T scalar) {
+    for (size_t i = 0; i < _size; i++) {
+        _data[i] = _data[i] * scalar;
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N>& SmallMVector<T, N>::operator/=(T scalar) {
+    if (scalar == T()) {
+        throw std::invalid_argument("SmallMVector: divide by zero");
+    }
+
+    for (size_t i = 0; i < _size; i++) {
+        _data[i] = _data[i] / scalar;
+    }
+
+    return *this;
+}
+
+template<typename T, size_t N>
+bool SmallMVector<T, N>::operator==(const SmallMVector& other) const {
+    if (_size != other._size) {
+        return false;
+    }
+
+    for (size_t i = 0; i < _size; i++) {
+        if (_data[i] != other._data[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename T, size_t N>
+bool SmallMVector<T, N>::operator!=(const SmallMVector& other) const {
+    return !(*this == other);
+}
+
+template<typename T, size_t N>
+T SmallMVector<T, N>::length() const {
+    return sqrt(*this * *this);
+}
+
+template<typename T, size_t N>
+SmallMVector<T, N> SmallMVector<T, N>::normalized() const {
+    T len = length();
+
+    if (len == 0) {
+        throw std::domain_error("Cannot normalize zero vector");
+    }
+
+    return *this / len;
+}
+
+template<typename T, size_t N>
+size_t SmallMVector<T, N>::size() const {
+    return _size;
+}
+
+template<typename T, size_t N>
+bool SmallMVector<T, N>::is_inline() const noexcept {
+    return _data == reinterpret_cast<const T*>(&_inline);
+}
+
+template<typename T, size_t N>
+size_t SmallMVector<T, N>::inline_capacity() noexcept {
+    return N;
+}
+
+template<typename T, size_t N>
+T* SmallMVector<T, N>::inline_data() noexcept {
+    return reinterpret_cast<T*>(&_inline);
+}
+
+// Points _data at storage for size elements, the vector must be empty.
+template<typename T, size_t N>
+void SmallMVector<T, N>::allocate(size_t size) {
+    if (size <= N) {
+        _data = inline_data();
+        return;
+    }
+
+    _data = static_cast<T*>(_resource->allocate(size * sizeof(T),
+        alignof(T)));
+}
+
+template<typename T, size_t N>
+void SmallMVector<T, N>::release() noexcept {
+    for (size_t i = 0; i < _size; i++) {
+        _data[i].~T();
+    }
+
+    if (!is_inline()) {
+        _resource->deallocate(_data, _size * sizeof(T), alignof(T));
+    }
+
+    _data = inline_data();
+    _size = 0;
+}
+
+#endif  // LIBS_LIB_SMALL_MVECTOR_SMALL_MVECTOR_H_
@@ -7,6 +7,8 @@
 #include <sstream>
 #include <string>
 #include <iomanip>
+#include <utility>
+#include "libs/lib_memory_resource/memory_resource.h"
 #include "libs/lib_mvector/mvector.h"
 
 namespace triangle_matrix_detail {
@@ -28,15 +30,19 @@ class TriangleMatrix {
  public:
     TriangleMatrix();
     explicit TriangleMatrix(size_t size);
+    TriangleMatrix(size_t size, MemoryResource* resource);
     TriangleMatrix(std::initializer_list<std::initializer_list<T>>);
     TriangleMatrix(const TriangleMatrix&);
+    TriangleMatrix(TriangleMatrix&&) noexcept;
 
     size_t dim() const;
+    MemoryResource* resource() const;
 
     bool operator==(const TriangleMatrix<T>&) const;
     bool operator!=(const TriangleMatrix<T>&) const;
 
     TriangleMatrix<T>& operator=(const TriangleMatrix<T>&);
+    TriangleMatrix<T>& operator=(TriangleMatrix<T>&&) noexcept;
 
     TriangleMatrix<T> operator+(const TriangleMatrix<T>&) const;
     TriangleMatrix<T> operator-(const TriangleMatrix<T>&) const;
@@ -69,11 +75,14 @@ template<typename T>
 TriangleMatrix<T>::TriangleMatrix() : _size(0), _data() {}
 
 template<typename T>
-TriangleMatrix<T>::TriangleMatrix(size_t size) : _size(size) {
-    _data = MVector<MVector<T>>(size);
+TriangleMatrix<T>::TriangleMatrix(size_t size) :
+    TriangleMatrix(size, get_default_resource()) {}
 
+template<typename T>
+TriangleMatrix<T>::TriangleMatrix(size_t size, MemoryResource* resource) :
+    _size(size), _data(size, resource) {
     for (size_t i = 0; i < size; i++) {
-        _data[i] = MVector<T>(size - i);
+        _data[i] = MVector<T>(size - i, resource);
     }
 }
 
@@ -106,6 +115,18 @@ TriangleMatrix<T>::TriangleMatrix(const TriangleMatrix& other) :
 _size(other._size), _data(other._data) {
 }
 
+// The other matrix is left empty.
+template<typename T>
+TriangleMatrix<T>::TriangleMatrix(TriangleMatrix&& other) noexcept :
+_size(other._size), _data(std::move(other._data)) {
+    other._size = 0;
+}
+
+template<typename T>
+MemoryResource* TriangleMatrix<T>::resource() const {
+    return _data.resource();
+}
+
 template<typename T>
 size_t TriangleMatrix<T>::dim() const {
     return _size;
@@ -144,6 +165,20 @@ operator=(const TriangleMatrix<T>& other) {
     return *this;
 }
 
+template<typename T>
+TriangleMatrix<T>& TriangleMatrix<T>::
+operator=(TriangleMatrix<T>&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    _size = other._size;
+    _data = std::move(other._data);
+    other._size = 0;
+
+    return *this;
+}
+
 template<typename T>
 TriangleMatrix<T> TriangleMatrix<T>::
 operator+(const TriangleMatrix<T>& other) const {
@@ -210,14 +245,28 @@ operator*(const TriangleMatrix<T>& other) const {
 template<typename T>
 TriangleMatrix<T>& TriangleMatrix<T>::
 operator+=(const TriangleMatrix<T>& other) {
-    *this = *this + other;
+    if (_size != other._size) {
+        throw std::invalid_argument("TriangleMatrix: Incompatible sizes");
+    }
+
+    for (size_t i = 0; i < _size; i++) {
+        _data[i] += other._data[i];
+    }
+
     return *this;
 }
 
 template<typename T>
 TriangleMatrix<T>& TriangleMatrix<T>::
 operator-=(const TriangleMatrix<T>& other) {
-    *this = *this - other;
+    if (_size != other._size) {
+        throw std::invalid_argument("TriangleMatrix: Incompatible sizes");
+    }
+
+    for (size_t i = 0; i < _size; i++) {
+        _data[i] -= other._data[i];
+    }
+
     return *this;
 }
 
@@ -252,13 +301,19 @@ TriangleMatrix<T> TriangleMatrix<T>::operator/(const T& scalar) const {
 
 template<typename T>
 TriangleMatrix<T>& TriangleMatrix<T>::operator*=(const T& scalar) {
-    *this = *this * scalar;
+    for (size_t i = 0; i < _size; i++) {
+        _data[i] *= scalar;
+    }
+
     return *this;
 }
 
 template<typename T>
 TriangleMatrix<T>& TriangleMatrix<T>::operator/=(const T& scalar) {
-    *this = *this / scalar;
+    for (size_t i = 0; i < _size; i++) {
+        _data[i] /= scalar;
+    }
+
     return *this;
 }
 
@@ -3,10 +3,38 @@
 #ifndef LIBS_LIB_TVECTOR_TVECTOR_H_
 #define LIBS_LIB_TVECTOR_TVECTOR_H_
 
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <thread>
 #include <utility>
 #include <ctime>
+#include "libs/lib_memory_resource/memory_resource.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TVECTOR_SSE2
+#endif
+
+// Iterators check every dereference against the live slots unless the
+// build defines NDEBUG. Define TVECTOR_CHECKED_ITERATORS to 0 or 1 to
+// pick the policy explicitly.
+#ifndef TVECTOR_CHECKED_ITERATORS
+#ifdef NDEBUG
+#define TVECTOR_CHECKED_ITERATORS 0
+#else
+#define TVECTOR_CHECKED_ITERATORS 1
+#endif
+#endif
 
 enum State {
     Empty,
@@ -14,16 +42,154 @@ enum State {
     Deleted
 };
 
+namespace tvector_detail {
+inline size_t popcount(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<size_t>(__popcnt64(word));
+#else
+    size_t count = 0;
+
+    for (; word != 0; word &= word - 1) {
+        count++;
+    }
+
+    return count;
+#endif
+}
+
+// Index of the lowest set bit, word must not be zero.
+inline size_t lowest_bit(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return index;
+#else
+    size_t index = 0;
+
+    for (; (word & 1) == 0; word >>= 1) {
+        index++;
+    }
+
+    return index;
+#endif
+}
+
+// Index of the highest set bit, word must not be zero.
+inline size_t highest_bit(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - static_cast<size_t>(__builtin_clzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return index;
+#else
+    size_t index = 63;
+
+    for (; (word >> 63) == 0; word <<= 1) {
+        index--;
+    }
+
+    return index;
+#endif
+}
+
+// Index of the n-th (from zero) set bit, word must have more than n bits.
+inline size_t select_bit(uint64_t word, size_t n) noexcept {
+    for (; n > 0; n--) {
+        word &= word - 1;
+    }
+
+    return lowest_bit(word);
+}
+}  // namespace tvector_detail
+
+// Geometric doubles the capacity on growth (amortized O(1) push_back),
+// FixedStep grows by _capacity_step only, for memory-tight users.
+enum GrowthPolicy {
+    Geometric,
+    FixedStep
+};
+
+// When Deleted slots are cleaned up. Threshold reallocates once they reach
+// removal_coefficient() of the slots, Manual leaves them to compact(),
+// Incremental moves up to compaction_step() elements into the holes on
+// every deletion, so no single call pays for the whole vector.
+enum CompactionPolicy {
+    Threshold,
+    Manual,
+    Incremental
+};
+
+// Predicates the find functions know: on arithmetic elements they test
+// 64 slots at a time, with SSE2 for int and float.
+template<typename T>
+struct EqualPredicate {
+    T value;
+
+    template<typename U>
+    bool operator()(const U& elem) const { return elem == value; }
+};
+
+template<typename T>
+struct RangePredicate {
+    T low;
+    T high;
+
+    template<typename U>
+    bool operator()(const U& elem) const {
+        return low <= elem && elem <= high;
+    }
+};
+
+template<typename T>
+EqualPredicate<T> tv_equal(T value) {
+    return EqualPredicate<T>{ value };
+}
+
+// Matches low <= elem <= high.
+template<typename T>
+RangePredicate<T> tv_between(T low, T high) {
+    return RangePredicate<T>{ low, high };
+}
+
 template<typename T>
 class TVector {
  private:
+    MemoryResource* _resource;
+    // Raw storage: slots in [_head, _used) hold live objects (Deleted ones
+    // too, until the next compaction), the slack on both sides of them is
+    // uninitialized.
     T* _data;
-    State* _states;
+    // One bit per slot, set for Busy. Slots in [_head, _used) with a clear
+    // bit are Deleted, the rest are Empty and always have a clear bit.
+    uint64_t* _busy;
     size_t _capacity;
     size_t _used;
     size_t _deleted;
+    // Empty slots in front of the first live one, push_front fills them
+    // without moving anything.
+    size_t _head = 0;
     size_t _capacity_step = 15;
     float _removal_coefficient = 0.15f;
+    GrowthPolicy _growth_policy = Geometric;
+    CompactionPolicy _compaction_policy = Threshold;
+    size_t _compaction_step = 16;
+    // No Deleted slot lies in [_head, _first_hole).
+    size_t _first_hole = 0;
+
+    static const size_t _word_bits = 64;
+
+    // Fenwick tree over the words of _busy, each node counts Busy slots.
+    // Every mutation that leaves Deleted slots keeps it actual, so lookups
+    // never scan _busy, and const ones never write it, so readers may share
+    // a vector.
+    size_t* _rank_tree = nullptr;
+    size_t _rank_blocks = 0;
+    bool _rank_actual = false;
 
  public:
     using value_type = T;
@@ -34,10 +200,13 @@ class TVector {
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
 
+    // Returned by the find functions when nothing matches.
+    static const size_type npos = static_cast<size_type>(-1);
+
     class Iterator {
      private:
         T* _ptr;
-        TVector<T>& _parent;
+        TVector<T>* _parent;
 
      public:
         using iterator_category = std::random_access_iterator_tag;
@@ -47,11 +216,9 @@ class TVector {
         using difference_type = TVector::difference_type;
 
         Iterator(T*, TVector<T>&) noexcept;
-        Iterator(const Iterator&) noexcept;
 
         inline reference operator*();
         inline pointer operator->() noexcept;
-        inline Iterator& operator=(const Iterator&) noexcept;
         Iterator& operator++() noexcept;
         inline Iterator operator++(int) noexcept;
         Iterator& operator--() noexcept;
@@ -74,7 +241,7 @@ class TVector {
     class ConstIterator {
      private:
         const T* _ptr;
-        const TVector<T>& _parent;
+        const TVector<T>* _parent;
 
      public:
         using iterator_category = std::random_access_iterator_tag;
@@ -84,7 +251,6 @@ class TVector {
         using difference_type = TVector::difference_type;
 
         ConstIterator(const T*, const TVector<T>&) noexcept;
-        ConstIterator(const ConstIterator&) noexcept;
 
         inline reference operator*();
         inline pointer operator->() noexcept;
@@ -108,12 +274,15 @@ class TVector {
     };
 
     TVector() noexcept;
+    explicit TVector(MemoryResource*) noexcept;
     explicit TVector(size_type) noexcept;
-    TVector(size_type, value_type);
+    TVector(size_type, value_type, MemoryResource* = get_default_resource());
     TVector(const TVector&) noexcept;
+    TVector(const TVector&, MemoryResource*) noexcept;
     TVector(TVector&&) noexcept;
-    TVector(pointer, size_type);
-    TVector(std::initializer_list<value_type>) noexcept;
+    TVector(pointer, size_type, MemoryResource* = get_default_resource());
+    TVector(std::initializer_list<value_type>,
+        MemoryResource* = get_default_resource()) noexcept;
     ~TVector() noexcept;
 
     inline pointer data() noexcept;
@@ -123,6 +292,7 @@ class TVector {
     inline size_type size() const noexcept;
     // inline size_type used() const noexcept;
     inline size_type capacity() const noexcept;
+    inline MemoryResource* resource() const noexcept;
     inline reference front();
     inline reference back();
     inline Iterator begin() noexcept;
@@ -130,6 +300,14 @@ class TVector {
     inline ConstIterator begin() const noexcept;
     inline ConstIterator end() const noexcept;
 
+    // Slot view for algorithms that split the vector into chunks: the
+    // elements are the live slots among data()[0, slot_count()), in order.
+    inline size_type slot_count() const noexcept;
+    inline bool is_dense() const noexcept;
+    inline size_type next_live(size_type slot) const noexcept;
+    inline size_type count_live(size_type first, size_type last)
+        const noexcept;
+
     void push_back(const value_type&) noexcept;
     void push_back(value_type&&) noexcept;
     void push_front(const value_type&) noexcept;
@@ -138,11 +316,28 @@ class TVector {
     Iterator insert(Iterator position, size_type n,
         const value_type& value) noexcept;
     Iterator insert(Iterator, value_type&&) noexcept;
+    template<class InputIt, class = typename std::enable_if<
+        !std::is_integral<InputIt>::value>::type>
+    Iterator insert(Iterator position, InputIt first, InputIt last);
+    template<class InputIt, class = typename std::enable_if<
+        !std::is_integral<InputIt>::value>::type>
+    void append(InputIt first, InputIt last);
+    void append(const TVector<T>&);
+    void append(TVector<T>&&);
     template <class... Args>
     Iterator emplace(Iterator position, Args&&... args);
+    template <class... Args>
+    reference emplace_back(Args&&... args);
+    template <class... Args>
+    reference emplace_front(Args&&... args);
     void pop_back();
     void pop_front();
     Iterator erase(Iterator);
+    Iterator erase(Iterator first, Iterator last);
+    template<class Predicate>
+    size_type erase_if(Predicate pred);
+    template<class Predicate>
+    size_type retain(Predicate pred);
 
     // TVector& assign(const TVector&);
     // reference at(size_type);
@@ -151,6 +346,18 @@ class TVector {
     void resize(size_type);
     void reserve(size_type);
     inline bool is_empty() const noexcept;
+    // The policies travel with the elements: copies, moves and
+    // assignments take the ones of the source vector, append() keeps the
+    // ones of the destination.
+    inline GrowthPolicy growth_policy() const noexcept;
+    inline void set_growth_policy(GrowthPolicy) noexcept;
+    inline CompactionPolicy compaction_policy() const noexcept;
+    inline void set_compaction_policy(CompactionPolicy) noexcept;
+    inline float removal_coefficient() const noexcept;
+    void set_removal_coefficient(float);
+    inline size_type compaction_step() const noexcept;
+    void set_compaction_step(size_type);
+    void compact();
     TVector& operator=(const TVector&) noexcept;
     TVector& operator=(TVector&&) noexcept;
     bool operator==(const TVector<value_type>&) const noexcept;
@@ -162,8 +369,26 @@ class TVector {
     friend std::ostream& operator<<(std::ostream&, const TVector<U>&) noexcept;
     template<typename U>
     friend void shuffle(TVector<U>&) noexcept;
-    template<typename U>
-    inline friend void tv_sort(TVector<U>&, bool(*comp)(U, U)) noexcept;
+    template<typename U, class Compare>
+    friend void tv_sort(TVector<U>&, Compare);
+    template<typename U, class Compare>
+    friend void tv_stable_sort(TVector<U>&, Compare);
+    template<typename U, class Compare>
+    friend void tv_partial_sort(TVector<U>&, size_t, Compare);
+    template<typename U, class Compare>
+    friend void tv_parallel_sort(TVector<U>&, Compare, size_t);
+    template<typename U, class KeyOf>
+    friend void tv_radix_sort(TVector<U>&, KeyOf);
+    template<typename U, class KeyOf>
+    friend void tv_radix_sort_in_place(TVector<U>&, KeyOf);
+    template<typename U, class Predicate>
+    friend size_t find_if(const TVector<U>&, Predicate);
+    template<typename U, class Predicate>
+    friend size_t find_last_if(const TVector<U>&, Predicate);
+    template<typename U, class Predicate>
+    friend size_t find_all(const TVector<U>&, Predicate, size_t*, size_t);
+    template<typename U, class Predicate>
+    friend class FindRange;
     template<typename U>
     friend int* search_all(TVector<U>&, bool(*check) (U)) noexcept;
     template<typename U>
@@ -173,150 +398,239 @@ class TVector {
 
  private:
     void reset_memory_for_delete() noexcept;
+    void take_storage(TVector*) noexcept;
+    inline void copy_policies(const TVector&) noexcept;
+    void after_delete() noexcept;
+    void compact_step(size_type) noexcept;
+    size_type next_deleted(size_type) const noexcept;
+    size_type slot_of(size_type) const noexcept;
     void reset_memory(size_type) noexcept;
     Iterator reset_memory(size_type, const Iterator&) noexcept;
+    void reallocate(size_type, size_type head = 0) noexcept;
+    size_type front_room() const noexcept;
+    size_type next_capacity(size_type) const noexcept;
     inline bool is_full() const noexcept;
-    template <typename U>
-    friend size_t partition(TVector<U>&, size_type,
-        size_type, bool (*comp)(U, U))noexcept;
-    template <typename U>
-    friend void quick_sort(TVector<U>&, size_type,
-        size_type, bool (*comp)(U, U)) noexcept;
+    void rebuild_rank() noexcept;
+    void update_rank(size_type, bool) noexcept;
+    void update_rank_range(size_type, size_type) noexcept;
+    inline void invalidate_rank() noexcept;
+    inline void sync_rank() noexcept;
+    void deallocate_ranks() noexcept;
+    size_type find_busy(size_type) const noexcept;
+    static inline size_type state_words(size_type) noexcept;
+    static void set_busy_prefix(uint64_t*, size_type) noexcept;
+    inline bool is_busy(size_type) const noexcept;
+    inline State state(size_type) const noexcept;
+    inline void set_busy(size_type, bool) noexcept;
+    void set_busy_range(size_type, size_type) noexcept;
+    size_type select_from(size_type, size_type) const noexcept;
+    size_type select_before(size_type, size_type) const noexcept;
+    inline size_type next_busy(size_type) const noexcept;
+    inline size_type prev_busy(size_type) const noexcept;
+    inline size_type end_slot() const noexcept;
+    size_type count_busy(size_type, size_type) const noexcept;
+    void shift_states(size_type, size_type) noexcept;
+    inline T* allocate(size_type);
+    inline void deallocate(T*, size_type) noexcept;
+    uint64_t* allocate_states(size_type);
+    inline void deallocate_states(uint64_t*, size_type) noexcept;
+    template<class ...Args>
+    inline void construct(size_type, Args&& ...);
+    static void destroy(T*, size_type) noexcept;
+    void copy_construct(T*, const T*, size_type);
+    template<class ForwardIt>
+    void construct_range(size_type, ForwardIt, size_type);
+    void construct_range(size_type, const T*, size_type);
+    void construct_range(size_type, T*, size_type);
+    template<class InputIt>
+    Iterator insert_range(Iterator, InputIt, InputIt, std::input_iterator_tag);
+    template<class ForwardIt>
+    Iterator insert_range(Iterator, ForwardIt, ForwardIt,
+        std::forward_iterator_tag);
+    template<class InputIt>
+    void append_range(InputIt, InputIt, std::input_iterator_tag);
+    template<class ForwardIt>
+    void append_range(ForwardIt, ForwardIt, std::forward_iterator_tag);
+    static void relocate(T*, T*, size_type) noexcept;
+    void relocate_busy(T*) noexcept;
+    size_type open_gap(const Iterator&, size_type) noexcept;
+    void pack() noexcept;
+    template<class Predicate>
+    void compact_from(size_type, size_type, Predicate&);
     inline void swap_elem(size_type, size_type) noexcept;
 };
 
 #pragma region TVectorRealization
 
 template<typename T>
-TVector<T>::TVector() noexcept : _data(nullptr), _states(nullptr),
-_capacity(0), _used(0), _deleted(0) {
+const typename TVector<T>::size_type TVector<T>::npos;
+
+template<typename T>
+TVector<T>::TVector() noexcept : TVector(get_default_resource()) {
+}
+
+template<typename T>
+TVector<T>::TVector(MemoryResource* resource) noexcept : _resource(resource),
+_data(nullptr), _busy(nullptr), _capacity(0), _used(0), _deleted(0) {
 }
 
 template<typename T>
-TVector<T>::TVector(size_type size) noexcept : _used(size), _deleted(0) {
+TVector<T>::TVector(size_type size) noexcept :
+    _resource(get_default_resource()), _used(size), _deleted(0) {
     _capacity = (size / _capacity_step + 1) * _capacity_step * (size > 0);
-    _data = new T[_capacity];
-    _states = new State[_capacity];
+    _data = allocate(_capacity);
+    _busy = allocate_states(_capacity);
 
     for (size_type i = 0; i < _used; i++) {
-        _data[i] = T();
-        _states[i] = Busy;
+        construct(i);
     }
 
-    for (size_type i = _used; i < _capacity; i++) {
-        _states[i] = Empty;
-    }
+    set_busy_prefix(_busy, _used);
 }
 
 template<typename T>
-TVector<T>::TVector(size_type size, value_type elem) :
-    _used(size), _deleted(0) {
+TVector<T>::TVector(size_type size, value_type elem,
+    MemoryResource* resource) : _resource(resource), _used(size), _deleted(0) {
     if (size == 0) {
         throw std::runtime_error("TVector with value"
             " can not be with zero size");
     }
 
     _capacity = (size / _capacity_step + 1) * _capacity_step * (size > 0);
-    _data = new T[_capacity];
-    _states = new State[_capacity];
+    _data = allocate(_capacity);
+    _busy = allocate_states(_capacity);
 
     for (size_type i = 0; i < _used; i++) {
-        _data[i] = elem;
-        _states[i] = Busy;
+        construct(i, elem);
     }
 
-    for (size_type i = _used; i < _capacity; i++) {
-        _states[i] = Empty;
-    }
+    set_busy_prefix(_busy, _used);
 }
 
 template<typename T>
-TVector<T>::TVector(const TVector& other) noexcept : _used(other._used),
-_deleted(other._deleted), _capacity(other._capacity),
-_data(new T[other._capacity]), _states(new State[other._capacity]) {
-    for (int i = 0; i < _used; i++) {
-        _data[i] = other._data[i];
-        _states[i] = other._states[i];
-    }
+TVector<T>::TVector(const TVector& other) noexcept :
+    TVector(other, get_default_resource()) {
+}
 
-    for (int i = _used; i < _capacity; i++) {
-        _states[i] = Empty;
+template<typename T>
+TVector<T>::TVector(const TVector& other, MemoryResource* resource) noexcept :
+_resource(resource), _data(allocate(other._capacity)),
+_busy(allocate_states(other._capacity)), _capacity(other._capacity),
+_used(other._used), _deleted(other._deleted), _head(other._head),
+_removal_coefficient(other._removal_coefficient),
+_growth_policy(other._growth_policy),
+_compaction_policy(other._compaction_policy),
+_compaction_step(other._compaction_step), _first_hole(other._first_hole) {
+    copy_construct(_data + _head, other._data + _head, _used - _head);
+
+    for (size_type i = 0; i < state_words(_capacity); i++) {
+        _busy[i] = other._busy[i];
     }
+
+    sync_rank();
 }
 
 template<typename T>
-TVector<T>::TVector(TVector&& other) noexcept :
-    _used(other._used), _deleted(other._deleted),
-    _capacity(other._capacity) {
-    _states = other._states;
-    other._states = nullptr;
-    _data = other._data;
+TVector<T>::TVector(TVector&& other) noexcept : _resource(other._resource),
+    _data(other._data), _busy(other._busy), _capacity(other._capacity),
+    _used(other._used), _deleted(other._deleted), _head(other._head),
+    _removal_coefficient(other._removal_coefficient),
+    _growth_policy(other._growth_policy),
+    _compaction_policy(other._compaction_policy),
+    _compaction_step(other._compaction_step), _first_hole(other._first_hole) {
+    other._busy = nullptr;
     other._data = nullptr;
     other._used = 0;
+    other._head = 0;
     other._deleted = 0;
     other._capacity = 0;
+    other.invalidate_rank();
+    sync_rank();
 }
 
 template<typename T>
-TVector<T>::TVector(pointer array, size_type size) : _used(size), _deleted(0) {
+TVector<T>::TVector(pointer array, size_type size, MemoryResource* resource) :
+    _resource(resource), _used(size), _deleted(0) {
     _capacity = (size / _capacity_step + 1) * _capacity_step * (size > 0);
-    _data = new T[_capacity];
-    _states = new State[_capacity];
-
-    for (size_type i = 0; i < _used; i++) {
-        _data[i] = array[i];
-        _states[i] = Busy;
-    }
+    _data = allocate(_capacity);
+    _busy = allocate_states(_capacity);
+    copy_construct(_data, array, _used);
 
-    for (size_type i = _used; i < _capacity; i++) {
-        _states[i] = Empty;
-    }
+    set_busy_prefix(_busy, _used);
 }
 
 template<typename T>
-TVector<T>::TVector(std::initializer_list<value_type> init) noexcept
-    : _used(init.size()), _deleted(0) {
+TVector<T>::TVector(std::initializer_list<value_type> init,
+    MemoryResource* resource) noexcept
+    : _resource(resource), _used(init.size()), _deleted(0) {
     if (init.size() <= 15)
         _capacity = _capacity_step * (init.size() > 0);
     else
         _capacity = (init.size() / _capacity_step + 1) *
         _capacity_step * (init.size() > 0);
 
-    _data = new T[_capacity];
-    _states = new State[_capacity];
-    size_t index = 0;
-
-    for (const auto& elem : init) {
-        _data[index] = elem;
-        _states[index] = Busy;
-        index++;
-    }
+    _data = allocate(_capacity);
+    _busy = allocate_states(_capacity);
+    copy_construct(_data, init.begin(), _used);
 
-    for (; index < _capacity; index++) {
-        _data[index] = T();
-        _states[index] = Empty;
-    }
+    set_busy_prefix(_busy, _used);
 }
 
 template<typename T>
 TVector<T>::~TVector() noexcept {
-    delete[] _data;
-    delete[] _states;
+    destroy(_data + _head, _used - _head);
+    deallocate(_data, _capacity);
+    deallocate_states(_busy, _capacity);
+    deallocate_ranks();
 }
 
 template<typename T>
 inline typename TVector<T>::pointer TVector<T>::data() noexcept {
-    return _data;
+    return _data + _head;
 }
 
 template<typename T>
 inline typename TVector<T>::const_pointer TVector<T>::data() const noexcept {
-    return _data;
+    return _data + _head;
+}
+
+template<typename T>
+inline typename TVector<T>::size_type TVector<T>::slot_count() const noexcept {
+    return _used - _head;
+}
+
+template<typename T>
+inline bool TVector<T>::is_dense() const noexcept {
+    return _deleted == 0;
+}
+
+// First live slot at or after slot, slot_count() if there is none.
+template<typename T>
+inline typename TVector<T>::size_type TVector<T>::next_live(size_type slot)
+const noexcept {
+    if (_deleted == 0)
+        return slot < _used - _head ? slot : _used - _head;
+
+    return next_busy(_head + slot) - _head;
+}
+
+// Live slots in [first, last).
+template<typename T>
+inline typename TVector<T>::size_type TVector<T>::count_live(size_type first,
+    size_type last) const noexcept {
+    if (_deleted == 0) {
+        if (last > _used - _head)
+            last = _used - _head;
+
+        return last > first ? last - first : 0;
+    }
+
+    return count_busy(_head + first, _head + last);
 }
 
 template<typename T>
 inline typename TVector<T>::size_type TVector<T>::size() const noexcept {
-    return _used - _deleted;
+    return _used - _head - _deleted;
 }
 
 template<typename T>
@@ -324,19 +638,18 @@ inline typename TVector<T>::size_type TVector<T>::capacity() const noexcept {
     return _capacity;
 }
 
+template<typename T>
+inline MemoryResource* TVector<T>::resource() const noexcept {
+    return _resource;
+}
+
 template<typename T>
 inline typename TVector<T>::reference TVector<T>::front() {
     if (is_empty()) {
         throw std::runtime_error("front() called on empty TVector");
     }
 
-    for (size_t i = 0; i < _used; i++) {
-        if (_states[i] == Busy)
-            return _data[i];
-    }
-
-    throw std::runtime_error("TVector internal state"
-        " corrupted: no busy elements found");
+    return _data[next_busy(0)];
 }
 
 template<typename T>
@@ -345,111 +658,77 @@ inline typename TVector<T>::reference TVector<T>::back() {
         throw std::runtime_error("back() called on empty TVector");
     }
 
-    for (size_t i = _used; i > 0; i--) {
-        if (_states[i - 1] == Busy)
-            return _data[i - 1];
-    }
-
-    throw std::runtime_error("TVector internal state"
-        " corrupted: no busy elements found");
+    return _data[prev_busy(_used)];
 }
 
 template<typename T>
 inline typename TVector<T>::Iterator TVector<T>::begin() noexcept {
     if (size() == 0) {
-        return Iterator(&_data[0], *this);
-    }
-
-    size_t begin_index = 0;
-
-    for (size_t i = 0; i < _used; i++) {
-        if (_states[i] == Busy) {
-            begin_index = i;
-            break;
-        }
+        return Iterator(_data + _head, *this);
     }
 
-    return Iterator(&_data[begin_index], *this);
+    return Iterator(&_data[next_busy(0)], *this);
 }
 
 template<typename T>
 inline typename TVector<T>::Iterator TVector<T>::end() noexcept {
     if (size() == 0) {
-        return Iterator(&_data[0], *this);
-    }
-
-    size_t end_index = _used;
-
-    for (size_t i = _used; i > 0; i--) {
-        if (_states[i - 1] == Busy) {
-            end_index = i;
-            break;
-        }
+        return Iterator(_data + _head, *this);
     }
 
-    return Iterator(&_data[end_index - 1] + 1, *this);
+    return Iterator(&_data[prev_busy(_used)] + 1, *this);
 }
 
 template<typename T>
 inline typename TVector<T>::ConstIterator TVector<T>::begin() const noexcept {
     if (size() == 0) {
-        return ConstIterator(&_data[0], *this);
-    }
-
-    size_t begin_index = 0;
-
-    for (size_t i = 0; i < _used; i++) {
-        if (_states[i] == Busy) {
-            begin_index = i;
-            break;
-        }
+        return ConstIterator(_data + _head, *this);
     }
 
-    return ConstIterator(&_data[begin_index], *this);
+    return ConstIterator(&_data[next_busy(0)], *this);
 }
 
 template<typename T>
 inline typename TVector<T>::ConstIterator TVector<T>::end() const noexcept {
     if (size() == 0) {
-        return ConstIterator(&_data[0], *this);
-    }
-
-    size_t end_index = _used;
-
-    for (size_t i = _used; i > 0; i--) {
-        if (_states[i - 1] == Busy) {
-            end_index = i;
-            break;
-        }
+        return ConstIterator(_data + _head, *this);
     }
 
-    return ConstIterator(&_data[end_index - 1] + 1, *this);
+    return ConstIterator(&_data[prev_busy(_used)] + 1, *this);
 }
 
 template<typename T>
 void TVector<T>::push_back(const value_type& value) noexcept {
-    if (_states != nullptr && _states[_used - 1] == Deleted) {
+    if (_used > _head && !is_busy(_used - 1)) {
         _data[_used - 1] = value;
-        _states[_used - 1] = Busy;
+        set_busy(_used - 1, true);
         _deleted--;
+        update_rank(_used - 1, true);
         return;
     }
 
     if (is_full()) {
+        // value may be one of our own elements, keep it alive across the
+        // reallocation.
+        value_type copy(value);
         reset_memory(size() + 1);
+        construct(_used, std::move(copy));
+    } else {
+        construct(_used, value);
     }
 
-    _data[_used] = value;
-    _states[_used] = Busy;
+    set_busy(_used, true);
+    update_rank(_used, true);
     _used++;
 }
 
 template<typename T>
 void TVector<T>::push_back(value_type&& value) noexcept {
-    if (_states != nullptr && _states[_used - 1] == Deleted) {
+    if (_used > _head && !is_busy(_used - 1)) {
         _data[_used - 1] = std::move(value);
-        _states[_used - 1] = Busy;
+        set_busy(_used - 1, true);
         _deleted--;
+        update_rank(_used - 1, true);
         return;
     }
 
@@ -457,291 +736,359 @@ void TVector<T>::push_back(value_type&& value) noexcept {
         reset_memory(size() + 1);
     }
 
-    _data[_used] = std::move(value);
-    _states[_used] = Busy;
+    construct(_used, std::move(value));
+    set_busy(_used, true);
+    update_rank(_used, true);
     _used++;
 }
 
 template<typename T>
 void TVector<T>::push_front(const value_type& value) noexcept {
-    if (_states != nullptr && _states[0] == Deleted) {
-        _data[0] = value;
-        _states[0] = Busy;
+    if (_used > _head && !is_busy(_head)) {
+        _data[_head] = value;
+        set_busy(_head, true);
         _deleted--;
+        update_rank(_head, true);
         return;
     }
 
-    if (is_full())
-        reset_memory(size() + 1);
-
-    for (size_t i = _used; i > 0; i--) {
-        _data[i] = _data[i - 1];
-        _states[i] = _states[i - 1];
-    }
-
-    _data[0] = value;
-    _states[0] = Busy;
-    _used++;
+    push_front(value_type(value));
 }
 
 template<typename T>
 void TVector<T>::push_front(value_type&& value) noexcept {
-    if (_states != nullptr && _states[0] == Deleted) {
-        _data[0] = std::move(value);
-        _states[0] = Busy;
+    if (_used > _head && !is_busy(_head)) {
+        _data[_head] = std::move(value);
+        set_busy(_head, true);
         _deleted--;
+        update_rank(_head, true);
         return;
     }
 
-    if (is_full())
-        reset_memory(size() + 1);
-
-    for (size_t i = _used; i > 0; i--) {
-        _data[i] = _data[i - 1];
-        _states[i] = _states[i - 1];
-    }
+    if (_head == 0)
+        reallocate(_capacity - _used + size() + front_room(), front_room());
 
-    _data[0] = std::move(value);
-    _states[0] = Busy;
-    _used++;
+    _head--;
+    construct(_head, std::move(value));
+    set_busy(_head, true);
+    update_rank(_head, true);
 }
 
 template<typename T>
 typename TVector<T>::Iterator TVector<T>::insert(Iterator position,
     const value_type& value) noexcept {
-    if (!is_full()) {
-        size_t insert_index = position.index();
-
-        for (size_t i = _used; i > insert_index; i--) {
-            _data[i] = _data[i - 1];
-            _states[i] = _states[i - 1];
-        }
+    return insert(position, value_type(value));
+}
 
-        _data[insert_index] = value;
-        _states[insert_index] = Busy;
-        _used++;
+template<typename T>
+typename TVector<T>::Iterator TVector<T>::insert(Iterator position,
+    size_type n, const value_type& value) noexcept {
+    value_type copy(value);
+    size_type insert_index = open_gap(position, n);
 
-        return position;
+    for (size_type i = insert_index; i < insert_index + n; i++) {
+        construct(i, copy);
+        set_busy(i, true);
     }
 
-    Iterator new_position = reset_memory(size() + 1, position);
+    sync_rank();
 
-    size_t insert_index = new_position.index();
+    return Iterator(&_data[insert_index], *this);
+}
 
-    for (size_t i = _used; i > insert_index; i--) {
-        _data[i] = _data[i - 1];
-        _states[i] = _states[i - 1];
-    }
+template<typename T>
+template<class ...Args>
+typename TVector<T>::Iterator TVector<T>::emplace(Iterator position,
+    Args && ...args) {
+    size_type insert_index = open_gap(position, 1);
 
-    _data[insert_index] = value;
-    _states[insert_index] = Busy;
-    _used++;
+    construct(insert_index, std::forward<Args>(args)...);
+    set_busy(insert_index, true);
+    sync_rank();
 
-    return new_position;
+    return Iterator(&_data[insert_index], *this);
 }
 
+// Constructs the element from args right in its slot. A Deleted slot at
+// the end is reused by assignment instead.
 template<typename T>
-typename TVector<T>::Iterator TVector<T>::insert(Iterator position,
-    size_type n, const value_type& value) noexcept {
-    if (_capacity - _used >= n) {
-        size_type insert_index = position.index();
-
-        for (size_type i = _used + n - 1; i >= insert_index + n; i--) {
-            _data[i] = _data[i - n];
-            _states[i] = _states[i - n];
-        }
-
-        for (size_type i = insert_index; i < insert_index + n; i++) {
-            _data[i] = value;
-            _states[i] = Busy;
-            _used++;
-        }
+template<class ...Args>
+typename TVector<T>::reference TVector<T>::emplace_back(Args&& ...args) {
+    if (_used > _head && !is_busy(_used - 1)) {
+        _data[_used - 1] = value_type(std::forward<Args>(args)...);
+        set_busy(_used - 1, true);
+        _deleted--;
+        update_rank(_used - 1, true);
+        return _data[_used - 1];
+    }
 
-        return position;
+    if (is_full()) {
+        // args may refer to our own elements, build the value before the
+        // reallocation moves them.
+        value_type value(std::forward<Args>(args)...);
+        reset_memory(size() + 1);
+        construct(_used, std::move(value));
+    } else {
+        construct(_used, std::forward<Args>(args)...);
     }
 
-    Iterator new_position = reset_memory(size() + n, position);
+    set_busy(_used, true);
+    update_rank(_used, true);
+    _used++;
 
-    size_t insert_index = new_position.index();
+    return _data[_used - 1];
+}
 
-    for (size_t i = _used + n - 1; i >= insert_index + n; i--) {
-        _data[i] = _data[i - n];
-        _states[i] = _states[i - n];
+template<typename T>
+template<class ...Args>
+typename TVector<T>::reference TVector<T>::emplace_front(Args&& ...args) {
+    if (_used > _head && !is_busy(_head)) {
+        _data[_head] = value_type(std::forward<Args>(args)...);
+        set_busy(_head, true);
+        _deleted--;
+        update_rank(_head, true);
+        return _data[_head];
     }
 
-    for (size_t i = insert_index; i < insert_index + n; i++) {
-        _data[i] = value;
-        _states[i] = Busy;
-        _used++;
+    if (_head == 0) {
+        value_type value(std::forward<Args>(args)...);
+        reallocate(_capacity - _used + size() + front_room(), front_room());
+        construct(_head - 1, std::move(value));
+    } else {
+        construct(_head - 1, std::forward<Args>(args)...);
     }
 
-    return new_position;
+    _head--;
+    set_busy(_head, true);
+    update_rank(_head, true);
+
+    return _data[_head];
 }
 
 template<typename T>
-template<class ...Args>
-typename TVector<T>::Iterator TVector<T>::emplace(Iterator position,
-    Args && ...args) {
-    if (!is_full()) {
-        size_t insert_index = position.index();
+typename TVector<T>::Iterator
+TVector<T>::insert(Iterator position, value_type&& value)
+noexcept {
+    size_type insert_index = open_gap(position, 1);
 
-        for (size_t i = _used; i > insert_index; i--) {
-            _data[i] = _data[i - 1];
-            _states[i] = _states[i - 1];
-        }
+    construct(insert_index, std::move(value));
+    set_busy(insert_index, true);
+    sync_rank();
 
-        _data[insert_index] = T(args ...);
-        _states[insert_index] = Busy;
-        _used++;
+    return Iterator(&_data[insert_index], *this);
+}
 
-        return position;
-    }
+// The range must not point into this vector.
+template<typename T>
+template<class InputIt, class>
+typename TVector<T>::Iterator TVector<T>::insert(Iterator position,
+    InputIt first, InputIt last) {
+    return insert_range(position, first, last,
+        typename std::iterator_traits<InputIt>::iterator_category());
+}
 
-    Iterator new_position = reset_memory(size() + 1, position);
+// The range must not point into this vector.
+template<typename T>
+template<class InputIt, class>
+void TVector<T>::append(InputIt first, InputIt last) {
+    append_range(first, last,
+        typename std::iterator_traits<InputIt>::iterator_category());
+}
 
-    size_t insert_index = new_position.index();
+template<typename T>
+void TVector<T>::append(const TVector<T>& other) {
+    size_type n = other.size();
 
-    for (size_t i = _used; i > insert_index; i--) {
-        _data[i] = _data[i - 1];
-        _states[i] = _states[i - 1];
-    }
+    if (n == 0)
+        return;
 
-    _data[insert_index] = T(args ...);
-    _states[insert_index] = Busy;
-    _used++;
+    // other may be this vector, its elements are read from the slots
+    // before _used only.
+    if (_capacity - _used < n)
+        reset_memory(size() + n);
 
-    return new_position;
+    if (other._deleted == 0) {
+        construct_range(_used, other._data + other._head, n);
+    } else {
+        ScopedDefaultResource scope(_resource);
+        size_type slot = _used;
+
+        for (size_type i = other.next_busy(other._head); i < other._used;
+            i = other.next_busy(i + 1)) {
+            ::new (static_cast<void*>(_data + slot)) T(other._data[i]);
+            slot++;
+        }
+    }
+
+    set_busy_range(_used, _used + n);
+    update_rank_range(_used, _used + n);
+    _used += n;
 }
 
+// Moves the elements of other to the end, other is left empty.
 template<typename T>
-typename TVector<T>::Iterator
-TVector<T>::insert(Iterator position, value_type&& value)
-noexcept {
-    if (!is_full()) {
-        size_t insert_index = position.index();
+void TVector<T>::append(TVector<T>&& other) {
+    if (this == &other) {
+        append(static_cast<const TVector<T>&>(other));
+        return;
+    }
 
-        for (size_t i = _used; i > insert_index; i--) {
-            _data[i] = _data[i - 1];
-            _states[i] = _states[i - 1];
-        }
+    // An empty vector takes the storage but keeps its own policies.
+    if (is_empty() && _resource == other._resource) {
+        take_storage(&other);
+        return;
+    }
 
-        _data[insert_index] = std::move(value);
-        _states[insert_index] = Busy;
-        _used++;
+    size_type n = other.size();
 
-        return position;
-    }
+    if (n == 0)
+        return;
 
-    Iterator new_position = reset_memory(size() + 1, position);
+    if (_capacity - _used < n)
+        reset_memory(size() + n);
 
-    size_t insert_index = new_position.index();
+    other.relocate_busy(_data + _used);
 
-    for (size_t i = _used; i > insert_index; i--) {
-        _data[i] = _data[i - 1];
-        _states[i] = _states[i - 1];
+    for (size_type i = 0; i < state_words(other._used); i++) {
+        other._busy[i] = 0;
     }
 
-    _data[insert_index] = std::move(value);
-    _states[insert_index] = Busy;
-    _used++;
+    other.invalidate_rank();
+    other._used = other._head;
+    other._deleted = 0;
 
-    return new_position;
+    set_busy_range(_used, _used + n);
+    update_rank_range(_used, _used + n);
+    _used += n;
 }
 
 template<typename T>
 void TVector<T>::pop_back() {
-    if (_states == nullptr || _data == nullptr)
+    if (is_empty())
         throw std::runtime_error("Pop with empty vector");
 
-    size_t remove_index = _used - 1;
-
-    for (size_t i = _used - 1; i > 0; i--) {
-        if (_states[i] == Busy) {
-            remove_index = i;
-            break;
-        }
-    }
+    size_t remove_index = prev_busy(_used);
 
-    _states[remove_index] = Deleted;
+    set_busy(remove_index, false);
     _deleted++;
-
-    if (_deleted >= _used * _removal_coefficient) {
-        reset_memory_for_delete();
-    }
+    update_rank(remove_index, false);
+    sync_rank();
+    after_delete();
 }
 
 template<typename T>
 void TVector<T>::pop_front() {
-    if (_states == nullptr || _data == nullptr)
+    if (is_empty())
         throw std::runtime_error("Pop with empty vector");
 
-    size_t remove_index = 0;
-
-    for (size_t i = 0; i < _used; i++) {
-        if (_states[i] == Busy) {
-            remove_index = i;
-            break;
-        }
-    }
+    size_t remove_index = next_busy(_head);
 
-    _states[remove_index] = Deleted;
+    set_busy(remove_index, false);
     _deleted++;
-
-    if (_deleted >= _used * _removal_coefficient) {
-        reset_memory_for_delete();
-    }
+    update_rank(remove_index, false);
+    sync_rank();
+    after_delete();
 }
 
 template<typename T>
 typename TVector<T>::Iterator TVector<T>::erase(Iterator position) {
-    if (_states == nullptr || _data == nullptr)
+    if (is_empty())
         throw std::runtime_error("Erase with empty vector");
 
     size_t deleted_index = position.index();
-    _states[deleted_index] = Deleted;
+    size_type next = count_busy(_head, deleted_index);
+
+    set_busy(deleted_index, false);
     _deleted++;
+    update_rank(deleted_index, false);
+    sync_rank();
+    after_delete();
 
-    if (_deleted >= _used * _removal_coefficient) {
-        reset_memory_for_delete();
-    }
+    return next < size() ? Iterator(&_data[slot_of(next)], *this) : end();
+}
+
+// Removes [first, last) by moving the elements behind it forward in one
+// pass, Deleted slots on the way are dropped too. Returns the iterator to
+// the element that followed the range.
+template<typename T>
+typename TVector<T>::Iterator TVector<T>::erase(Iterator first,
+    Iterator last) {
+    size_type from = first.index();
+    size_type to = last.index();
+
+    if (to < from)
+        throw std::invalid_argument("Erase with reversed range");
+
+    if (from == to)
+        return last;
+
+    auto none = [](const T&) { return false; };
+
+    compact_from(from, to, none);
+    _deleted = (from - _head) - count_busy(_head, from);
+    sync_rank();
+
+    return from < _used ? Iterator(&_data[from], *this) : end();
+}
+
+// Removes every element matching pred in one pass without reallocating,
+// returns how many were removed.
+template<typename T>
+template<class Predicate>
+typename TVector<T>::size_type TVector<T>::erase_if(Predicate pred) {
+    size_type before = size();
+
+    compact_from(_head, _head, pred);
+    _deleted = 0;
 
-    return position;  // TODO(chernykh): fix to return valid iterator.
+    return before - size();
+}
+
+// Keeps only the elements matching pred.
+template<typename T>
+template<class Predicate>
+typename TVector<T>::size_type TVector<T>::retain(Predicate pred) {
+    return erase_if([&pred](const T& elem) { return !pred(elem); });
 }
 
 template<typename T>
 void TVector<T>::clear() noexcept {
-    delete[] _data;
-    delete[] _states;
+    destroy(_data + _head, _used - _head);
+    deallocate(_data, _capacity);
+    deallocate_states(_busy, _capacity);
+    invalidate_rank();
     _capacity = _capacity_step;
     _deleted = 0;
     _used = 0;
+    _head = 0;
 
-    _data = new T[_capacity];
-    _states = new State[_capacity];
-
-    for (int i = 0; i < _capacity; i++) {
-        _data[i] = T();
-        _states[i] = Empty;
-    }
+    _data = allocate(_capacity);
+    _busy = allocate_states(_capacity);
 }
 
 template<typename T>
 void TVector<T>::shrink_to_fit() {
-    _capacity = _used;
+    if (_head > 0)
+        pack();
+
+    invalidate_rank();
+
+    T* new_data = allocate(_used);
+    uint64_t* new_busy = allocate_states(_used);
 
-    T* new_data = new T[_capacity];
-    State* new_states = new State[_capacity];
+    relocate(new_data, _data, _used);
 
-    for (int i = 0; i < _capacity; i++) {
-        new_data[i] = _data[i];
-        new_states[i] = _states[i];
+    for (size_type i = 0; i < state_words(_used); i++) {
+        new_busy[i] = _busy[i];
     }
 
-    delete[] _data;
-    delete[] _states;
+    deallocate(_data, _capacity);
+    deallocate_states(_busy, _capacity);
 
+    _capacity = _used;
     _data = new_data;
-    _states = new_states;
+    _busy = new_busy;
+    sync_rank();
 }
 
 template<typename T>
@@ -749,19 +1096,18 @@ void TVector<T>::resize(size_type new_size) {
     reset_memory_for_delete();
 
     if (new_size > _capacity) {
-        reset_memory(new_size);
-        for (size_type i = _used; i < new_size; i++) {
-            _states[i] = Busy;
-        }
+        reallocate((new_size / _capacity_step + 1) * _capacity_step);
+    }
 
-        _used = new_size;
-    } else if (new_size > _used) {
+    if (new_size > _used) {
         for (size_type i = _used; i < new_size; i++) {
-            _states[i] = Busy;
+            construct(i);
         }
 
+        set_busy_prefix(_busy, new_size);
         _used = new_size;
     } else {
+        destroy(_data + new_size, _used - new_size);
         _used = new_size;
         reset_memory_for_delete();
     }
@@ -772,8 +1118,9 @@ inline void TVector<T>::reserve(size_type new_size) {
     reset_memory_for_delete();
 
     if (new_size > _capacity) {
-        reset_memory(new_size);
+        reallocate((new_size / _capacity_step + 1) * _capacity_step);
     } else if (new_size < _used) {
+        destroy(_data + new_size, _used - new_size);
         _used = new_size;
         reset_memory_for_delete();
     }
@@ -781,294 +1128,2150 @@ inline void TVector<T>::reserve(size_type new_size) {
 
 template<typename T>
 inline bool TVector<T>::is_empty() const noexcept {
-    return (_used - _deleted) == 0;
+    return size() == 0;
 }
 
 template<typename T>
-TVector<T>& TVector<T>::operator=(const TVector& other) noexcept {
-    if (this != &other) {
-        delete[] _data;
-        delete[] _states;
+inline GrowthPolicy TVector<T>::growth_policy() const noexcept {
+    return _growth_policy;
+}
 
-        _capacity = other._capacity;
-        _used = other._used;
-        _deleted = other._deleted;
-        _data = new T[_capacity];
-        _states = new State[_capacity];
+template<typename T>
+inline void TVector<T>::set_growth_policy(GrowthPolicy policy) noexcept {
+    _growth_policy = policy;
+}
 
-        for (size_t i = 0; i < _used; i++) {
-            _data[i] = other._data[i];
-            _states[i] = other._states[i];
-        }
+template<typename T>
+inline CompactionPolicy TVector<T>::compaction_policy() const noexcept {
+    return _compaction_policy;
+}
 
-        for (size_t i = _used; i < _capacity; i++) {
-            _states[i] = Empty;
-        }
-    }
+template<typename T>
+inline void TVector<T>::set_compaction_policy(CompactionPolicy policy)
+noexcept {
+    _compaction_policy = policy;
+}
 
-    return *this;
+template<typename T>
+inline float TVector<T>::removal_coefficient() const noexcept {
+    return _removal_coefficient;
 }
 
+// Share of Deleted slots that makes the Threshold policy compact.
 template<typename T>
-TVector<T>& TVector<T>::operator=(TVector&& other) noexcept {
+void TVector<T>::set_removal_coefficient(float coefficient) {
+    if (!(coefficient > 0.0f && coefficient <= 1.0f)) {
+        throw std::invalid_argument("TVector: removal coefficient must be"
+            " in (0, 1]");
+    }
+
+    _removal_coefficient = coefficient;
+}
+
+template<typename T>
+inline typename TVector<T>::size_type TVector<T>::compaction_step()
+const noexcept {
+    return _compaction_step;
+}
+
+// Elements the Incremental policy moves per deletion.
+template<typename T>
+void TVector<T>::set_compaction_step(size_type step) {
+    if (step == 0)
+        throw std::invalid_argument("TVector: compaction step must be"
+            " positive");
+
+    _compaction_step = step;
+}
+
+// Removes every Deleted slot in place, the storage is kept.
+template<typename T>
+void TVector<T>::compact() {
+    if (_deleted == 0)
+        return;
+
+    auto none = [](const T&) { return false; };
+
+    compact_from(_head, _head, none);
+    _deleted = 0;
+}
+
+template<typename T>
+TVector<T>& TVector<T>::operator=(const TVector& other) noexcept {
     if (this != &other) {
-        delete[] _data;
-        delete[] _states;
+        destroy(_data + _head, _used - _head);
+        deallocate(_data, _capacity);
+        deallocate_states(_busy, _capacity);
+        invalidate_rank();
+
+        _capacity = other._capacity;
+        _used = other._used;
+        _deleted = other._deleted;
+        _head = other._head;
+        _first_hole = other._first_hole;
+        copy_policies(other);
+        _data = allocate(_capacity);
+        _busy = allocate_states(_capacity);
+        copy_construct(_data + _head, other._data + _head, _used - _head);
+
+        for (size_t i = 0; i < state_words(_capacity); i++) {
+            _busy[i] = other._busy[i];
+        }
+
+        sync_rank();
+    }
+
+    return *this;
+}
+
+template<typename T>
+TVector<T>& TVector<T>::operator=(TVector&& other) noexcept {
+    if (this != &other && _resource != other._resource) {
+        // Storage can not change hands between resources, move element-wise.
+        destroy(_data + _head, _used - _head);
+        deallocate(_data, _capacity);
+        deallocate_states(_busy, _capacity);
+        invalidate_rank();
+        other.invalidate_rank();
+
         _capacity = other._capacity;
         _used = other._used;
         _deleted = other._deleted;
-        _data = other._data;
-        other._data = nullptr;
-        _states = other._states;
-        other._states = nullptr;
-        other._capacity = 0;
+        _head = other._head;
+        _first_hole = other._first_hole;
+        copy_policies(other);
+        _data = allocate(_capacity);
+        _busy = allocate_states(_capacity);
+        relocate(_data + _head, other._data + _head, _used - _head);
+
+        for (size_t i = 0; i < state_words(_capacity); i++) {
+            _busy[i] = other._busy[i];
+            other._busy[i] = 0;
+        }
+
         other._used = 0;
         other._deleted = 0;
+        other._head = 0;
+        sync_rank();
+    } else if (this != &other) {
+        take_storage(&other);
+        copy_policies(other);
+    }
+
+    return *this;
+}
+
+// Frees the elements of this vector and takes the ones of other, which
+// has to use the same resource. The policies stay as they are.
+template<typename T>
+void TVector<T>::take_storage(TVector* other) noexcept {
+    destroy(_data + _head, _used - _head);
+    deallocate(_data, _capacity);
+    deallocate_states(_busy, _capacity);
+    invalidate_rank();
+    other->invalidate_rank();
+    _capacity = other->_capacity;
+    _used = other->_used;
+    _deleted = other->_deleted;
+    _head = other->_head;
+    _first_hole = other->_first_hole;
+    _data = other->_data;
+    other->_data = nullptr;
+    _busy = other->_busy;
+    other->_busy = nullptr;
+    other->_capacity = 0;
+    other->_used = 0;
+    other->_deleted = 0;
+    other->_head = 0;
+    sync_rank();
+}
+
+template<typename T>
+inline void TVector<T>::copy_policies(const TVector& other) noexcept {
+    _removal_coefficient = other._removal_coefficient;
+    _growth_policy = other._growth_policy;
+    _compaction_policy = other._compaction_policy;
+    _compaction_step = other._compaction_step;
+}
+
+template<typename T>
+bool TVector<T>::operator==(const TVector<value_type>& other) const noexcept {
+    if (size() != other.size())
+        return false;
+
+    size_type j = other.next_busy(0);
+
+    for (size_type i = next_busy(0); i < _used; i = next_busy(i + 1)) {
+        if (_data[i] != other._data[j])
+            return false;
+
+        j = other.next_busy(j + 1);
+    }
+
+    return true;
+}
+
+template<typename T>
+bool TVector<T>::operator!=(const TVector<value_type>& other) const noexcept {
+    return !(*this == other);
+}
+
+template<typename T>
+typename TVector<T>::reference TVector<T>::operator[](size_type index) {
+    if (index >= size()) {
+        throw std::out_of_range("TVector operator[]: Index out of range.");
+    }
+
+    return _data[slot_of(index)];
+}
+
+template<typename T>
+typename TVector<T>::const_reference
+TVector<T>::operator[](size_type index) const {
+    if (index >= size()) {
+        throw std::out_of_range("TVector operator[]: Index out of range.");
+    }
+
+    return _data[slot_of(index)];
+}
+
+template<typename T>
+void TVector<T>::reset_memory_for_delete() noexcept {
+    reallocate((size() / _capacity_step + 1) * _capacity_step);
+}
+
+template<typename T>
+void TVector<T>::after_delete() noexcept {
+    switch (_compaction_policy) {
+    case Threshold:
+        if (_deleted >= (_used - _head) * _removal_coefficient)
+            reset_memory_for_delete();
+        break;
+    case Incremental:
+        compact_step(_compaction_step);
+        break;
+    case Manual:
+        break;
+    }
+}
+
+// Moves up to budget elements, in order, into the earliest Deleted slots.
+// Once every Deleted slot is behind the last element they are dropped.
+template<typename T>
+void TVector<T>::compact_step(size_type budget) noexcept {
+    if (_deleted == 0)
+        return;
+
+    size_type hole = next_deleted(_first_hole);
+    size_type next = next_busy(hole);
+
+    // The slots between hole and next are Deleted, so after a move the
+    // next hole is right behind the filled one.
+    for (; budget > 0 && next < _used; budget--) {
+        _data[hole] = std::move(_data[next]);
+        set_busy(hole, true);
+        update_rank(hole, true);
+        set_busy(next, false);
+        update_rank(next, false);
+        hole++;
+        next = next_busy(next + 1);
+    }
+
+    _first_hole = hole;
+
+    if (next >= _used) {
+        destroy(_data + hole, _used - hole);
+        _used = hole;
+        _deleted = 0;
+    }
+}
+
+// First Deleted slot at or after first, _used if there is none.
+template<typename T>
+typename TVector<T>::size_type
+TVector<T>::next_deleted(size_type first) const noexcept {
+    if (first < _head)
+        first = _head;
+
+    if (first >= _used)
+        return _used;
+
+    size_type word = first / _word_bits;
+    uint64_t holes = ~_busy[word] & (~uint64_t(0) << (first % _word_bits));
+
+    while (holes == 0) {
+        word++;
+
+        if (word >= state_words(_used))
+            return _used;
+
+        holes = ~_busy[word];
+    }
+
+    size_type slot = word * _word_bits + tvector_detail::lowest_bit(holes);
+
+    return slot < _used ? slot : _used;
+}
+
+// Slot of the element at logical index.
+template<typename T>
+inline typename TVector<T>::size_type TVector<T>::slot_of(size_type index)
+const noexcept {
+    if (_deleted == 0)
+        return _head + index;
+
+    return find_busy(index);
+}
+
+template<typename T>
+void TVector<T>::reset_memory(size_type new_size) noexcept {
+    // Mostly front room or tombstones: packing is enough, do not grow.
+    if (new_size <= _capacity / 2)
+        reallocate(_capacity);
+    else
+        reallocate(next_capacity(new_size));
+}
+
+// Moves the Busy elements to new storage starting at slot head.
+template<typename T>
+void TVector<T>::reallocate(size_type new_capacity, size_type head)
+noexcept {
+    size_type correct_size = size();
+    T* new_data = allocate(new_capacity);
+    uint64_t* new_busy = allocate_states(new_capacity);
+
+    relocate_busy(new_data + head);
+    set_busy_prefix(new_busy, head + correct_size);
+
+    for (size_type i = 0; i < head; i++) {
+        new_busy[i / _word_bits] &= ~(uint64_t(1) << (i % _word_bits));
+    }
+
+    invalidate_rank();
+    deallocate(_data, _capacity);
+    deallocate_states(_busy, _capacity);
+    _capacity = new_capacity;
+    _deleted = 0;
+    _used = head + correct_size;
+    _head = head;
+    _data = new_data;
+    _busy = new_busy;
+}
+
+// Front room push_front asks for when it runs out of it, grows with the
+// vector unless the growth policy is FixedStep.
+template<typename T>
+typename TVector<T>::size_type TVector<T>::front_room() const noexcept {
+    if (_growth_policy == Geometric && size() > _capacity_step)
+        return size();
+
+    return _capacity_step;
+}
+
+template<typename T>
+typename TVector<T>::Iterator TVector<T>::reset_memory(size_type new_size,
+    const Iterator& insert_it) noexcept {
+    size_type new_insert_index = count_busy(0, insert_it.index());
+    reset_memory(new_size);
+
+    return Iterator(&_data[new_insert_index], *this);
+}
+
+template<typename T>
+typename TVector<T>::size_type TVector<T>::next_capacity(size_type new_size)
+const noexcept {
+    size_type new_capacity = (new_size / _capacity_step + 1) * _capacity_step;
+
+    if (_growth_policy == Geometric && new_capacity < _capacity * 2) {
+        new_capacity = _capacity * 2;
+    }
+
+    return new_capacity;
+}
+
+template<typename T>
+inline bool TVector<T>::is_full() const noexcept {
+    return _used == _capacity;
+}
+
+template<typename T>
+void TVector<T>::rebuild_rank() noexcept {
+    size_type words = state_words(_capacity);
+
+    if (words != _rank_blocks || _rank_tree == nullptr) {
+        deallocate_ranks();
+        _rank_tree = static_cast<size_t*>(_resource->allocate(
+            (words + 1) * sizeof(size_t), alignof(size_t)));
+        _rank_blocks = words;
+    }
+
+    _rank_tree[0] = 0;
+
+    for (size_type i = 0; i < _rank_blocks; i++) {
+        _rank_tree[i + 1] = tvector_detail::popcount(_busy[i]);
+    }
+
+    for (size_type i = 1; i <= _rank_blocks; i++) {
+        size_type parent = i + (i & (~i + 1));
+
+        if (parent <= _rank_blocks)
+            _rank_tree[parent] += _rank_tree[i];
+    }
+
+    _rank_actual = true;
+}
+
+template<typename T>
+void TVector<T>::update_rank(size_type slot, bool busy) noexcept {
+    if (!_rank_actual)
+        return;
+
+    for (size_type i = slot / _word_bits + 1; i <= _rank_blocks;
+        i += i & (~i + 1)) {
+        if (busy)
+            _rank_tree[i]++;
+        else
+            _rank_tree[i]--;
+    }
+}
+
+// Adds the slots [first, last), just marked Busy, to the rank tree.
+template<typename T>
+void TVector<T>::update_rank_range(size_type first, size_type last)
+noexcept {
+    if (!_rank_actual)
+        return;
+
+    while (first < last) {
+        size_type word = first / _word_bits;
+        size_type end = (word + 1) * _word_bits;
+
+        if (end > last)
+            end = last;
+
+        for (size_type i = word + 1; i <= _rank_blocks; i += i & (~i + 1)) {
+            _rank_tree[i] += end - first;
+        }
+
+        first = end;
+    }
+}
+
+template<typename T>
+inline void TVector<T>::invalidate_rank() noexcept {
+    _rank_actual = false;
+}
+
+// Called after a mutation that may leave Deleted slots with a stale tree.
+template<typename T>
+inline void TVector<T>::sync_rank() noexcept {
+    if (_deleted > 0 && !_rank_actual)
+        rebuild_rank();
+}
+
+template<typename T>
+void TVector<T>::deallocate_ranks() noexcept {
+    if (_rank_tree != nullptr) {
+        _resource->deallocate(_rank_tree, (_rank_blocks + 1) * sizeof(size_t),
+            alignof(size_t));
+        _rank_tree = nullptr;
+        _rank_blocks = 0;
+        _rank_actual = false;
+    }
+}
+
+template<typename T>
+typename TVector<T>::size_type TVector<T>::find_busy(size_type index)
+const noexcept {
+    size_type word = 0;
+
+    if (!_rank_actual) {
+        size_type bits = tvector_detail::popcount(_busy[word]);
+
+        while (index >= bits) {
+            index -= bits;
+            bits = tvector_detail::popcount(_busy[++word]);
+        }
+
+        return word * _word_bits +
+            tvector_detail::select_bit(_busy[word], index);
+    }
+
+    size_type step = 1;
+
+    while (step * 2 <= _rank_blocks)
+        step *= 2;
+
+    for (; step > 0; step /= 2) {
+        if (word + step <= _rank_blocks &&
+            _rank_tree[word + step] <= index) {
+            word += step;
+            index -= _rank_tree[word];
+        }
+    }
+
+    return word * _word_bits + tvector_detail::select_bit(_busy[word], index);
+}
+
+template<typename T>
+inline typename TVector<T>::size_type
+TVector<T>::state_words(size_type capacity) noexcept {
+    return (capacity + _word_bits - 1) / _word_bits;
+}
+
+template<typename T>
+void TVector<T>::set_busy_prefix(uint64_t* words, size_type count) noexcept {
+    size_type full_words = count / _word_bits;
+
+    for (size_type i = 0; i < full_words; i++) {
+        words[i] = ~uint64_t(0);
+    }
+
+    if (count % _word_bits != 0) {
+        words[full_words] |= (uint64_t(1) << (count % _word_bits)) - 1;
+    }
+}
+
+// Marks the slots [from, to) Busy, a word at a time where possible.
+template<typename T>
+void TVector<T>::set_busy_range(size_type from, size_type to) noexcept {
+    for (; from < to && from % _word_bits != 0; from++) {
+        set_busy(from, true);
+    }
+
+    for (; from + _word_bits <= to; from += _word_bits) {
+        _busy[from / _word_bits] = ~uint64_t(0);
+    }
+
+    for (; from < to; from++) {
+        set_busy(from, true);
+    }
+}
+
+template<typename T>
+inline bool TVector<T>::is_busy(size_type slot) const noexcept {
+    return (_busy[slot / _word_bits] >> (slot % _word_bits)) & 1;
+}
+
+template<typename T>
+inline State TVector<T>::state(size_type slot) const noexcept {
+    if (slot >= _used || slot < _head)
+        return Empty;
+
+    return is_busy(slot) ? Busy : Deleted;
+}
+
+template<typename T>
+inline void TVector<T>::set_busy(size_type slot, bool busy) noexcept {
+    uint64_t mask = uint64_t(1) << (slot % _word_bits);
+
+    if (busy) {
+        _busy[slot / _word_bits] |= mask;
+    } else {
+        _busy[slot / _word_bits] &= ~mask;
+
+        if (slot < _first_hole)
+            _first_hole = slot;
+    }
+}
+
+// Slot of the n-th (from zero) Busy slot at or after first, _used if the
+// vector has fewer Busy slots there.
+template<typename T>
+typename TVector<T>::size_type
+TVector<T>::select_from(size_type first, size_type n) const noexcept {
+    if (first >= _used)
+        return _used;
+
+    size_type word = first / _word_bits;
+    size_type words = state_words(_used);
+    uint64_t bits = _busy[word] & (~uint64_t(0) << (first % _word_bits));
+
+    while (true) {
+        size_type count = tvector_detail::popcount(bits);
+
+        if (n < count)
+            return word * _word_bits + tvector_detail::select_bit(bits, n);
+
+        n -= count;
+        word++;
+
+        if (word >= words)
+            return _used;
+
+        bits = _busy[word];
+    }
+}
+
+// Slot of the n-th (from zero) Busy slot going backward from last
+// (exclusive), npos if the vector has fewer Busy slots there.
+template<typename T>
+typename TVector<T>::size_type
+TVector<T>::select_before(size_type last, size_type n) const noexcept {
+    if (last > _used)
+        last = _used;
+
+    if (last == 0)
+        return npos;
+
+    size_type word = (last - 1) / _word_bits;
+    uint64_t bits = _busy[word] &
+        (~uint64_t(0) >> (_word_bits - 1 - (last - 1) % _word_bits));
+
+    while (true) {
+        size_type count = tvector_detail::popcount(bits);
+
+        if (n == 0 && count > 0)
+            return word * _word_bits + tvector_detail::highest_bit(bits);
+
+        if (n < count) {
+            return word * _word_bits +
+                tvector_detail::select_bit(bits, count - 1 - n);
+        }
+
+        n -= count;
+
+        if (word == 0)
+            return npos;
+
+        word--;
+        bits = _busy[word];
+    }
+}
+
+template<typename T>
+inline typename TVector<T>::size_type
+TVector<T>::next_busy(size_type first) const noexcept {
+    return select_from(first, 0);
+}
+
+template<typename T>
+inline typename TVector<T>::size_type
+TVector<T>::prev_busy(size_type last) const noexcept {
+    return select_before(last, 0);
+}
+
+// Slot that end() points to: one past the last Busy slot.
+template<typename T>
+inline typename TVector<T>::size_type TVector<T>::end_slot() const noexcept {
+    if (size() == 0)
+        return _head;
+
+    return prev_busy(_used) + 1;
+}
+
+template<typename T>
+typename TVector<T>::size_type
+TVector<T>::count_busy(size_type first, size_type last) const noexcept {
+    if (last > _used)
+        last = _used;
+
+    if (first >= last)
+        return 0;
+
+    size_type first_word = first / _word_bits;
+    size_type last_word = (last - 1) / _word_bits;
+    uint64_t head_mask = ~uint64_t(0) << (first % _word_bits);
+    uint64_t tail_mask =
+        ~uint64_t(0) >> (_word_bits - 1 - (last - 1) % _word_bits);
+
+    if (first_word == last_word)
+        return tvector_detail::popcount(_busy[first_word] & head_mask &
+            tail_mask);
+
+    size_type count = tvector_detail::popcount(_busy[first_word] & head_mask);
+
+    for (size_type i = first_word + 1; i < last_word; i++) {
+        count += tvector_detail::popcount(_busy[i]);
+    }
+
+    return count + tvector_detail::popcount(_busy[last_word] & tail_mask);
+}
+
+// Moves the states of [from, _used) n slots to the right, the caller then
+// fills the freed slots [from, from + n).
+template<typename T>
+void TVector<T>::shift_states(size_type from, size_type n) noexcept {
+    for (size_type i = _used + n; i > from + n; i--) {
+        set_busy(i - 1, is_busy(i - 1 - n));
+    }
+}
+
+template<typename T>
+inline T* TVector<T>::allocate(size_type count) {
+    return static_cast<T*>(_resource->allocate(count * sizeof(T), alignof(T)));
+}
+
+template<typename T>
+inline void TVector<T>::deallocate(T* data, size_type count) noexcept {
+    if (data != nullptr)
+        _resource->deallocate(data, count * sizeof(T), alignof(T));
+}
+
+// Zeroed state words for capacity slots.
+template<typename T>
+uint64_t* TVector<T>::allocate_states(size_type capacity) {
+    size_type words = state_words(capacity);
+    uint64_t* states = static_cast<uint64_t*>(_resource->allocate(
+        words * sizeof(uint64_t), alignof(uint64_t)));
+
+    for (size_type i = 0; i < words; i++) {
+        states[i] = 0;
+    }
+
+    return states;
+}
+
+template<typename T>
+inline void TVector<T>::deallocate_states(uint64_t* states, size_type capacity)
+noexcept {
+    if (states != nullptr) {
+        _resource->deallocate(states, state_words(capacity) * sizeof(uint64_t),
+            alignof(uint64_t));
+    }
+}
+
+// Elements that allocate on their own (nested containers) are constructed
+// with the vector's resource as the default, so they share it.
+template<typename T>
+template<class ...Args>
+inline void TVector<T>::construct(size_type slot, Args&& ...args) {
+    if (std::is_trivially_copyable<T>::value) {
+        ::new (static_cast<void*>(_data + slot)) T(std::forward<Args>(args)...);
+        return;
+    }
+
+    ScopedDefaultResource scope(_resource);
+    ::new (static_cast<void*>(_data + slot)) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void TVector<T>::destroy(T* first, size_type count) noexcept {
+    if (std::is_trivially_destructible<T>::value)
+        return;
+
+    for (size_type i = 0; i < count; i++) {
+        first[i].~T();
+    }
+}
+
+template<typename T>
+void TVector<T>::copy_construct(T* dest, const T* source, size_type count) {
+    if (std::is_trivially_copyable<T>::value) {
+        if (count > 0)
+            std::memcpy(static_cast<void*>(dest), source, count * sizeof(T));
+        return;
+    }
+
+    ScopedDefaultResource scope(_resource);
+
+    for (size_type i = 0; i < count; i++) {
+        ::new (static_cast<void*>(dest + i)) T(source[i]);
+    }
+}
+
+// Copy constructs n elements from first into the raw slots from slot on.
+template<typename T>
+template<class ForwardIt>
+void TVector<T>::construct_range(size_type slot, ForwardIt first,
+    size_type n) {
+    ScopedDefaultResource scope(_resource);
+
+    for (size_type i = slot; i < slot + n; i++, ++first) {
+        ::new (static_cast<void*>(_data + i)) T(*first);
+    }
+}
+
+template<typename T>
+void TVector<T>::construct_range(size_type slot, const T* first,
+    size_type n) {
+    copy_construct(_data + slot, first, n);
+}
+
+template<typename T>
+void TVector<T>::construct_range(size_type slot, T* first, size_type n) {
+    copy_construct(_data + slot, first, n);
+}
+
+// Single pass ranges are buffered first, so the gap is opened only once.
+template<typename T>
+template<class InputIt>
+typename TVector<T>::Iterator TVector<T>::insert_range(Iterator position,
+    InputIt first, InputIt last, std::input_iterator_tag) {
+    TVector<T> buffer(_resource);
+
+    buffer.append(first, last);
+
+    return insert(position, std::make_move_iterator(buffer.begin()),
+        std::make_move_iterator(buffer.end()));
+}
+
+template<typename T>
+template<class ForwardIt>
+typename TVector<T>::Iterator TVector<T>::insert_range(Iterator position,
+    ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+    size_type n = std::distance(first, last);
+
+    if (n == 0)
+        return position;
+
+    size_type insert_index = open_gap(position, n);
+
+    construct_range(insert_index, first, n);
+    set_busy_range(insert_index, insert_index + n);
+    sync_rank();
+
+    return Iterator(&_data[insert_index], *this);
+}
+
+template<typename T>
+template<class InputIt>
+void TVector<T>::append_range(InputIt first, InputIt last,
+    std::input_iterator_tag) {
+    for (; first != last; ++first) {
+        push_back(value_type(*first));
+    }
+}
+
+template<typename T>
+template<class ForwardIt>
+void TVector<T>::append_range(ForwardIt first, ForwardIt last,
+    std::forward_iterator_tag) {
+    size_type n = std::distance(first, last);
+
+    if (n == 0)
+        return;
+
+    if (_capacity - _used < n)
+        reset_memory(size() + n);
+
+    construct_range(_used, first, n);
+    set_busy_range(_used, _used + n);
+    update_rank_range(_used, _used + n);
+    _used += n;
+}
+
+// Moves count objects into raw dest and ends their lifetime in source.
+template<typename T>
+void TVector<T>::relocate(T* dest, T* source, size_type count) noexcept {
+    if (std::is_trivially_copyable<T>::value) {
+        if (count > 0)
+            std::memcpy(static_cast<void*>(dest), source, count * sizeof(T));
+        return;
+    }
+
+    for (size_type i = 0; i < count; i++) {
+        ::new (static_cast<void*>(dest + i)) T(std::move(source[i]));
+        source[i].~T();
+    }
+}
+
+// Packs the Busy elements into raw dest and destroys every live slot,
+// the states are left for the caller to rebuild.
+template<typename T>
+void TVector<T>::relocate_busy(T* dest) noexcept {
+    if (_deleted == 0) {
+        relocate(dest, _data + _head, _used - _head);
+        return;
+    }
+
+    size_type index = 0;
+
+    for (size_type i = next_busy(_head); i < _used; i = next_busy(i + 1)) {
+        ::new (static_cast<void*>(dest + index)) T(std::move(_data[i]));
+        index++;
+    }
+
+    destroy(_data + _head, _used - _head);
+}
+
+// Makes room for n elements at position and returns the first slot of the
+// gap. The elements before position move into the front room when there is
+// enough of it and they are fewer than the ones after, otherwise the tail
+// moves right, growing the storage if needed. The gap is left uninitialized
+// with clear states and is already counted in _used, the caller constructs
+// into it and marks it Busy.
+template<typename T>
+typename TVector<T>::size_type
+TVector<T>::open_gap(const Iterator& position, size_type n) noexcept {
+    size_type from = position.index();
+
+    if (n == 0)
+        return from;
+
+    invalidate_rank();
+
+    if (_head >= n && from - _head < _used - from) {
+        size_type to = _head - n;
+
+        if (std::is_trivially_copyable<T>::value) {
+            if (from > _head) {
+                std::memmove(static_cast<void*>(_data + to), _data + _head,
+                    (from - _head) * sizeof(T));
+            }
+        } else {
+            for (size_type i = _head; i < from; i++) {
+                if (i - n < _head)
+                    construct(i - n, std::move(_data[i]));
+                else
+                    _data[i - n] = std::move(_data[i]);
+            }
+
+            size_type live = from - n > _head ? from - n : _head;
+            destroy(_data + live, from - live);
+        }
+
+        for (size_type i = _head; i < from; i++) {
+            set_busy(i - n, is_busy(i));
+        }
+
+        for (size_type i = from - n; i < from; i++) {
+            set_busy(i, false);
+        }
+
+        _head = to;
+
+        return from - n;
+    }
+
+    if (_capacity - _used < n)
+        from = reset_memory(size() + n, position).index();
+
+    invalidate_rank();
+
+    if (std::is_trivially_copyable<T>::value) {
+        if (_used > from) {
+            std::memmove(static_cast<void*>(_data + from + n), _data + from,
+                (_used - from) * sizeof(T));
+        }
+    } else {
+        for (size_type i = _used + n; i > from + n; i--) {
+            if (i - 1 >= _used)
+                construct(i - 1, std::move(_data[i - 1 - n]));
+            else
+                _data[i - 1] = std::move(_data[i - 1 - n]);
+        }
+
+        destroy(_data + from, (from + n < _used ? from + n : _used) - from);
+    }
+
+    shift_states(from, n);
+
+    for (size_type i = from; i < from + n; i++) {
+        set_busy(i, false);
+    }
+
+    _used += n;
+
+    return from;
+}
+
+// Drops the slots [from, skip_to) and, from skip_to on, the Deleted slots
+// and the Busy ones matching pred, moving the rest to from in order. The
+// storage is kept and _used becomes the slot after the last moved element,
+// the caller fixes _deleted for the slots before from.
+template<typename T>
+template<class Predicate>
+void TVector<T>::compact_from(size_type from, size_type skip_to,
+    Predicate& pred) {
+    size_type out = from;
+
+    for (size_type i = next_busy(skip_to); i < _used; i = next_busy(i + 1)) {
+        if (pred(_data[i]))
+            continue;
+
+        if (i != out)
+            _data[out] = std::move(_data[i]);
+
+        out++;
+    }
+
+    destroy(_data + out, _used - out);
+
+    for (size_type i = from; i < _used; i++) {
+        set_busy(i, i < out);
+    }
+
+    invalidate_rank();
+    _used = out;
+}
+
+// Moves the Busy elements to slot 0 in order and destroys the slots behind
+// them, the storage is kept.
+template<typename T>
+void TVector<T>::pack() noexcept {
+    if (_deleted == 0 && _head == 0)
+        return;
+
+    size_type index = 0;
+
+    for (size_type i = next_busy(_head); i < _used; i = next_busy(i + 1)) {
+        if (index < _head)
+            construct(index, std::move(_data[i]));
+        else if (i != index)
+            _data[index] = std::move(_data[i]);
+
+        index++;
+    }
+
+    size_type live = index > _head ? index : _head;
+    destroy(_data + live, _used - live);
+
+    for (size_type i = 0; i < state_words(_used); i++) {
+        _busy[i] = 0;
+    }
+
+    set_busy_prefix(_busy, index);
+    invalidate_rank();
+    _used = index;
+    _deleted = 0;
+    _head = 0;
+}
+
+template<typename T>
+inline void TVector<T>::swap_elem(size_type first_index, size_type second_index)
+noexcept {
+    std::swap(_data[first_index], _data[second_index]);
+
+    bool first_busy = is_busy(first_index);
+    bool second_busy = is_busy(second_index);
+
+    if (first_busy != second_busy) {
+        set_busy(first_index, second_busy);
+        set_busy(second_index, first_busy);
+        update_rank(first_index, second_busy);
+        update_rank(second_index, first_busy);
+    }
+}
+
+template<typename T>
+std::ostream& operator<<(std::ostream& stream, const TVector<T>& out) noexcept {
+    stream << "size(" << out._used << ") capacity(" <<
+        out._capacity << ") deleted(" << out._deleted << ") vector: [ ";
+
+    size_t out_size = out.size() > 1000 ? 1000 : out.size();
+
+    for (size_t i = out.next_busy(0); i < out._used && out_size > 0;
+        i = out.next_busy(i + 1)) {
+        stream << out._data[i] << " ";
+        out_size--;
+    }
+
+    stream << " ]";
+
+    return stream;
+}
+
+template<typename U>
+void shuffle(TVector<U>& vec) noexcept {
+    // Only [_head, _used) holds constructed elements.
+    if (vec._used - vec._head < 2)
+        return;
+
+    std::srand(std::time(0));
+
+    for (size_t i = vec._used - 1; i > vec._head; --i) {
+        size_t j = vec._head + std::rand() % (i - vec._head + 1);
+        vec.swap_elem(i, j);
+    }
+}
+
+namespace tvector_detail {
+// Ranges up to this length are finished with insertion sort.
+const ptrdiff_t sort_threshold = 16;
+
+template<typename T, class Compare>
+void insertion_sort(T* first, T* last, Compare& comp) {
+    if (first == last)
+        return;
+
+    for (T* i = first + 1; i < last; i++) {
+        T value = std::move(*i);
+        T* j = i;
+
+        for (; j > first && comp(value, *(j - 1)); j--) {
+            *j = std::move(*(j - 1));
+        }
+
+        *j = std::move(value);
+    }
+}
+
+template<typename T, class Compare>
+void sift_down(T* first, ptrdiff_t root, ptrdiff_t size, Compare& comp) {
+    T value = std::move(first[root]);
+
+    while (true) {
+        ptrdiff_t child = 2 * root + 1;
+
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && comp(first[child], first[child + 1]))
+            child++;
+
+        if (!comp(value, first[child]))
+            break;
+
+        first[root] = std::move(first[child]);
+        root = child;
+    }
+
+    first[root] = std::move(value);
+}
+
+template<typename T, class Compare>
+void make_heap(T* first, ptrdiff_t size, Compare& comp) {
+    for (ptrdiff_t i = size / 2; i > 0; i--) {
+        sift_down(first, i - 1, size, comp);
+    }
+}
+
+template<typename T, class Compare>
+void heap_sort(T* first, T* last, Compare& comp) {
+    ptrdiff_t size = last - first;
+
+    make_heap(first, size, comp);
+
+    for (ptrdiff_t end = size - 1; end > 0; end--) {
+        std::swap(first[0], first[end]);
+        sift_down(first, 0, end, comp);
+    }
+}
+
+template<typename T, class Compare>
+T* median_of_three(T* a, T* b, T* c, Compare& comp) {
+    if (comp(*a, *b)) {
+        if (comp(*b, *c))
+            return b;
+
+        return comp(*a, *c) ? c : a;
+    }
+
+    if (comp(*a, *c))
+        return a;
+
+    return comp(*b, *c) ? c : b;
+}
+
+// Moves the pivot (median of three, ninther on long ranges) to *first and
+// partitions the rest around it. Candidates are taken from [first + 1, last),
+// so both scans are stopped by one of them and need no bounds checks.
+template<typename T, class Compare>
+T* partition_pivot(T* first, T* last, Compare& comp) {
+    ptrdiff_t size = last - first;
+    T* mid = first + size / 2;
+    T* pivot;
+
+    if (size > 128) {
+        ptrdiff_t step = size / 8;
+        pivot = median_of_three(
+            median_of_three(first + 1, first + 1 + step, first + 1 + 2 * step,
+                comp),
+            median_of_three(mid - step, mid, mid + step, comp),
+            median_of_three(last - 1 - 2 * step, last - 1 - step, last - 1,
+                comp),
+            comp);
+    } else {
+        pivot = median_of_three(first + 1, mid, last - 1, comp);
+    }
+
+    std::swap(*first, *pivot);
+
+    T* low = first + 1;
+    T* high = last;
+
+    while (true) {
+        while (comp(*low, *first)) {
+            low++;
+        }
+
+        high--;
+
+        while (comp(*first, *high)) {
+            high--;
+        }
+
+        if (!(low < high))
+            return low;
+
+        std::swap(*low, *high);
+        low++;
+    }
+}
+
+template<typename T, class Compare>
+void introsort(T* first, T* last, size_t depth, Compare& comp) {
+    while (last - first > sort_threshold) {
+        if (depth == 0) {
+            heap_sort(first, last, comp);
+            return;
+        }
+
+        depth--;
+
+        T* cut = partition_pivot(first, last, comp);
+
+        // Recursing into the shorter side keeps the stack logarithmic.
+        if (cut - first < last - cut) {
+            introsort(first, cut, depth, comp);
+            first = cut;
+        } else {
+            introsort(cut, last, depth, comp);
+            last = cut;
+        }
+    }
+
+    insertion_sort(first, last, comp);
+}
+
+// buffer is raw storage for at least (last - first) / 2 elements.
+template<typename T, class Compare>
+void merge_sort(T* first, T* last, T* buffer, Compare& comp) {
+    ptrdiff_t size = last - first;
+
+    if (size <= sort_threshold) {
+        insertion_sort(first, last, comp);
+        return;
+    }
+
+    T* mid = first + size / 2;
+
+    merge_sort(first, mid, buffer, comp);
+    merge_sort(mid, last, buffer, comp);
+
+    if (!comp(*mid, *(mid - 1)))
+        return;
+
+    ptrdiff_t left = mid - first;
+
+    for (ptrdiff_t i = 0; i < left; i++) {
+        ::new (static_cast<void*>(buffer + i)) T(std::move(first[i]));
+    }
+
+    T* from_left = buffer;
+    T* from_right = mid;
+    T* out = first;
+
+    while (from_left < buffer + left && from_right < last) {
+        if (comp(*from_right, *from_left))
+            *out++ = std::move(*from_right++);
+        else
+            *out++ = std::move(*from_left++);
+    }
+
+    while (from_left < buffer + left) {
+        *out++ = std::move(*from_left++);
+    }
+
+    for (ptrdiff_t i = 0; i < left; i++) {
+        buffer[i].~T();
+    }
+}
+
+inline size_t sort_depth_limit(size_t size) noexcept {
+    size_t depth = 0;
+
+    for (; size > 1; size /= 2) {
+        depth += 2;
+    }
+
+    return depth;
+}
+
+// Ranges shorter than this per thread are not worth a thread of their own.
+const size_t parallel_sort_grain = 1 << 14;
+
+// Threads that run the phases of one parallel algorithm, created once for
+// all of them. run() hands the indices of a phase out one by one, the
+// calling thread works on them too, and returns once every task is done.
+class PhaseWorkers {
+ private:
+    std::thread* _threads;
+    size_t _thread_count;
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    void (*_call)(void*, size_t);
+    void* _task;
+    size_t _next;
+    size_t _total;
+    size_t _pending;
+    bool _stop;
+
+ public:
+    // threads is the total concurrency including the caller.
+    explicit PhaseWorkers(size_t threads);
+    PhaseWorkers(const PhaseWorkers&) = delete;
+    PhaseWorkers& operator=(const PhaseWorkers&) = delete;
+    ~PhaseWorkers() noexcept;
+
+    // Calls task(i) for every i in [0, count).
+    template<class Task>
+    void run(size_t count, Task& task);
+
+ private:
+    template<class Task>
+    static void call(void* task, size_t index) {
+        (*static_cast<Task*>(task))(index);
+    }
+
+    void work() noexcept;
+    bool run_next(std::unique_lock<std::mutex>& lock) noexcept;
+};
+
+inline PhaseWorkers::PhaseWorkers(size_t threads) : _threads(nullptr),
+    _thread_count(0), _call(nullptr), _task(nullptr), _next(0), _total(0),
+    _pending(0), _stop(false) {
+    if (threads > 1) {
+        _threads = new std::thread[threads - 1];
+
+        for (; _thread_count < threads - 1; _thread_count++) {
+            _threads[_thread_count] = std::thread(&PhaseWorkers::work, this);
+        }
+    }
+}
+
+inline PhaseWorkers::~PhaseWorkers() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+
+    _wake.notify_all();
+
+    for (size_t i = 0; i < _thread_count; i++) {
+        _threads[i].join();
+    }
+
+    delete[] _threads;
+}
+
+template<class Task>
+void PhaseWorkers::run(size_t count, Task& task) {
+    if (count == 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _call = &call<Task>;
+    _task = &task;
+    _next = 0;
+    _total = count;
+    _pending = count;
+
+    _wake.notify_all();
+
+    while (run_next(lock)) {}
+
+    _done.wait(lock, [this]() { return _pending == 0; });
+    _task = nullptr;
+}
+
+inline void PhaseWorkers::work() noexcept {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        _wake.wait(lock, [this]() { return _stop || _next < _total; });
+
+        if (_stop)
+            return;
+
+        while (run_next(lock)) {}
+    }
+}
+
+// Runs one task of the current phase, false once it has no tasks left to
+// hand out. Called and returns with lock held.
+inline bool PhaseWorkers::run_next(std::unique_lock<std::mutex>& lock)
+noexcept {
+    if (_next >= _total)
+        return false;
+
+    size_t index = _next++;
+    void (*function)(void*, size_t) = _call;
+    void* task = _task;
+
+    lock.unlock();
+    function(task, index);
+    lock.lock();
+
+    if (--_pending == 0)
+        _done.notify_all();
+
+    return true;
+}
+
+// Number of elements a[0, i) the first out elements of the stable merge of
+// a[0, a_size) and b[0, b_size) take from a, the rest come from b.
+template<typename T, class Compare>
+size_t merge_split(const T* a, size_t a_size, const T* b, size_t b_size,
+    size_t out, Compare& comp) {
+    size_t low = out > b_size ? out - b_size : 0;
+    size_t high = out < a_size ? out : a_size;
+
+    while (low < high) {
+        size_t i = low + (high - low) / 2;
+        size_t j = out - i;
+
+        if (j > 0 && !comp(b[j - 1], a[i]))
+            low = i + 1;
+        else
+            high = i;
+    }
+
+    return low;
+}
+
+// Moves value to out, constructing it there when out is raw storage.
+template<typename T>
+void move_to(T* out, T& value, bool raw) {
+    if (raw)
+        ::new (static_cast<void*>(out)) T(std::move(value));
+    else
+        *out = std::move(value);
+}
+
+template<typename T, class Compare>
+void merge_move(T* a, T* a_last, T* b, T* b_last, T* out, bool raw,
+    Compare& comp) {
+    while (a < a_last && b < b_last) {
+        if (comp(*b, *a))
+            move_to(out++, *b++, raw);
+        else
+            move_to(out++, *a++, raw);
+    }
+
+    for (; a < a_last; a++) {
+        move_to(out++, *a, raw);
+    }
+
+    for (; b < b_last; b++) {
+        move_to(out++, *b, raw);
+    }
+}
+
+// Unsigned image of a radix sort key that compares the same way as the key:
+// signed integers get the sign bit flipped, negative floats all bits. NaNs
+// go to the ends according to their sign bit.
+template<typename K, bool = std::is_floating_point<K>::value>
+struct radix_key {
+    static_assert(std::is_integral<K>::value,
+        "radix sort: key must be an integral or floating point type");
+    typedef typename std::make_unsigned<K>::type type;
+
+    static type get(K key) noexcept {
+        type bits = static_cast<type>(key);
+
+        if (std::is_signed<K>::value)
+            bits ^= static_cast<type>(type(1) << (sizeof(K) * 8 - 1));
+
+        return bits;
+    }
+};
+
+template<typename K>
+struct radix_key<K, true> {
+    static_assert(sizeof(K) == 4 || sizeof(K) == 8,
+        "radix sort: only 32 and 64 bit floating point keys are supported");
+    typedef typename std::conditional<sizeof(K) == 4, uint32_t,
+        uint64_t>::type type;
+
+    static type get(K key) noexcept {
+        const type sign = type(1) << (sizeof(K) * 8 - 1);
+        type bits;
+
+        std::memcpy(&bits, &key, sizeof(K));
+
+        return (bits & sign) ? static_cast<type>(~bits) : (bits | sign);
+    }
+};
+
+// Ranges up to this length are left to comparison sorts.
+const size_t radix_sort_threshold = 256;
+
+// Stable LSD radix sort with 8 bit digits for keys up to 16 bits and 11 bit
+// digits above. buffer is raw storage for size elements, passes where every
+// key has the same digit are skipped.
+template<typename T, class KeyOf>
+void lsd_radix_sort(T* data, size_t size, T* buffer, KeyOf& key_of) {
+    typedef radix_key<typename std::decay<decltype(key_of(*data))>::type> key;
+    typedef typename key::type bits_type;
+    const size_t key_bits = sizeof(bits_type) * 8;
+    const size_t digit_bits = key_bits <= 16 ? 8 : 11;
+    const size_t radix = size_t(1) << digit_bits;
+    const size_t passes = (key_bits + digit_bits - 1) / digit_bits;
+    size_t* counts = new size_t[passes * radix]();
+
+    for (size_t i = 0; i < size; i++) {
+        bits_type bits = key::get(key_of(data[i]));
+
+        for (size_t pass = 0; pass < passes; pass++) {
+            counts[pass * radix +
+                ((bits >> (pass * digit_bits)) & (radix - 1))]++;
+        }
+    }
+
+    T* from = data;
+    T* to = buffer;
+    bool raw = true;
+
+    for (size_t pass = 0; pass < passes; pass++) {
+        size_t* count = counts + pass * radix;
+        size_t shift = pass * digit_bits;
+
+        if (count[(key::get(key_of(from[0])) >> shift) & (radix - 1)] == size)
+            continue;
+
+        for (size_t digit = 0, sum = 0; digit < radix; digit++) {
+            size_t digit_count = count[digit];
+            count[digit] = sum;
+            sum += digit_count;
+        }
+
+        for (size_t i = 0; i < size; i++) {
+            size_t digit = (key::get(key_of(from[i])) >> shift) & (radix - 1);
+            move_to(to + count[digit]++, from[i], raw);
+        }
+
+        std::swap(from, to);
+        raw = false;
+    }
+
+    if (from != data) {
+        for (size_t i = 0; i < size; i++) {
+            data[i] = std::move(buffer[i]);
+        }
+    }
+
+    if (!raw) {
+        for (size_t i = 0; i < size; i++) {
+            buffer[i].~T();
+        }
+    }
+
+    delete[] counts;
+}
+
+// In-place MSD radix sort on 8 bit digits, starting at bit shift: elements
+// are swapped straight into their buckets, then every bucket is sorted on
+// the next digit.
+template<typename T, class KeyOf>
+void american_flag_sort(T* first, T* last, size_t shift, KeyOf& key_of) {
+    typedef radix_key<typename std::decay<decltype(key_of(*first))>::type>
+        key;
+
+    if (static_cast<size_t>(last - first) <= radix_sort_threshold) {
+        auto less = [&key_of](const T& a, const T& b) {
+            return key::get(key_of(a)) < key::get(key_of(b));
+        };
+        introsort(first, last, sort_depth_limit(last - first), less);
+        return;
+    }
+
+    size_t start[256] = {};
+    size_t next[256];
+    size_t end[256];
+
+    for (T* elem = first; elem < last; elem++) {
+        start[(key::get(key_of(*elem)) >> shift) & 0xFF]++;
+    }
+
+    for (size_t digit = 0, sum = 0; digit < 256; digit++) {
+        size_t digit_count = start[digit];
+        start[digit] = sum;
+        next[digit] = sum;
+        sum += digit_count;
+        end[digit] = sum;
+    }
+
+    for (size_t bucket = 0; bucket < 256; bucket++) {
+        while (next[bucket] < end[bucket]) {
+            size_t digit = (key::get(key_of(first[next[bucket]])) >> shift)
+                & 0xFF;
+
+            if (digit == bucket)
+                next[bucket]++;
+            else
+                std::swap(first[next[bucket]], first[next[digit]++]);
+        }
+    }
+
+    if (shift == 0)
+        return;
+
+    for (size_t bucket = 0; bucket < 256; bucket++) {
+        if (end[bucket] - start[bucket] > 1) {
+            american_flag_sort(first + start[bucket], first + end[bucket],
+                shift - 8, key_of);
+        }
+    }
+}
+
+// Bit i is set when slot i of the block is Busy and matches pred, busy is
+// the block's word of the Busy bitmap. Only Busy slots are read.
+template<typename T, class Predicate>
+uint64_t sparse_mask(const T* block, uint64_t busy, Predicate& pred) {
+    uint64_t mask = 0;
+
+    for (; busy != 0; busy &= busy - 1) {
+        size_t bit = lowest_bit(busy);
+
+        if (pred(block[bit]))
+            mask |= uint64_t(1) << bit;
+    }
+
+    return mask;
+}
+
+// Same for a block of count <= 64 slots that are all live.
+template<typename T, class Predicate>
+uint64_t match_mask(const T* block, size_t, uint64_t busy,
+    Predicate& pred) {
+    return sparse_mask(block, busy, pred);
+}
+
+// Known predicates on arithmetic slots test the whole block without
+// branches (Deleted slots hold plain numbers too) and mask by busy after.
+template<typename T, class Predicate>
+uint64_t dense_mask(const T* block, size_t count, const Predicate& pred) {
+    uint64_t mask = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        mask |= static_cast<uint64_t>(pred(block[i])) << i;
+    }
+
+    return mask;
+}
+
+#ifdef TVECTOR_SSE2
+inline uint64_t dense_mask(const int* block, size_t count,
+    const EqualPredicate<int>& pred) {
+    const __m128i value = _mm_set1_epi32(pred.value);
+    uint64_t mask = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i data = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(block + i));
+        int bits = _mm_movemask_ps(_mm_castsi128_ps(
+            _mm_cmpeq_epi32(data, value)));
+        mask |= static_cast<uint64_t>(bits) << i;
     }
 
-    return *this;
+    for (; i < count; i++) {
+        mask |= static_cast<uint64_t>(pred(block[i])) << i;
+    }
+
+    return mask;
 }
 
-template<typename T>
-bool TVector<T>::operator==(const TVector<value_type>& other) const noexcept {
-    if (size() != other.size())
-        return false;
+inline uint64_t dense_mask(const int* block, size_t count,
+    const RangePredicate<int>& pred) {
+    const __m128i low = _mm_set1_epi32(pred.low);
+    const __m128i high = _mm_set1_epi32(pred.high);
+    uint64_t mask = 0;
+    size_t i = 0;
 
-    for (size_type i = 0; i < size(); i++) {
-        if ((*this)[i] != other[i])
-            return false;
+    for (; i + 4 <= count; i += 4) {
+        __m128i data = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(block + i));
+        __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(low, data),
+            _mm_cmpgt_epi32(data, high));
+        int bits = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+        mask |= static_cast<uint64_t>(bits) << i;
     }
 
-    return true;
-}
+    for (; i < count; i++) {
+        mask |= static_cast<uint64_t>(pred(block[i])) << i;
+    }
 
-template<typename T>
-bool TVector<T>::operator!=(const TVector<value_type>& other) const noexcept {
-    return !(*this == other);
+    return mask;
 }
 
-template<typename T>
-typename TVector<T>::reference TVector<T>::operator[](size_type index) {
-    if (index >= _used) {
-        throw std::out_of_range("TVector operator[]: Index out of range.");
+inline uint64_t dense_mask(const float* block, size_t count,
+    const EqualPredicate<float>& pred) {
+    const __m128 value = _mm_set1_ps(pred.value);
+    uint64_t mask = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        int bits = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(block + i),
+            value));
+        mask |= static_cast<uint64_t>(bits) << i;
     }
 
-    if (_deleted == 0) {
-        return _data[index];
+    for (; i < count; i++) {
+        mask |= static_cast<uint64_t>(pred(block[i])) << i;
     }
 
-    size_type current_index = 0;
+    return mask;
+}
 
-    for (size_type i = 0; i < _used; i++) {
-        if (_states[i] == Busy) {
-            if (current_index == index)
-                return _data[i];
+inline uint64_t dense_mask(const float* block, size_t count,
+    const RangePredicate<float>& pred) {
+    const __m128 low = _mm_set1_ps(pred.low);
+    const __m128 high = _mm_set1_ps(pred.high);
+    uint64_t mask = 0;
+    size_t i = 0;
 
-            current_index++;
-        }
+    for (; i + 4 <= count; i += 4) {
+        __m128 data = _mm_loadu_ps(block + i);
+        int bits = _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(data, low),
+            _mm_cmple_ps(data, high)));
+        mask |= static_cast<uint64_t>(bits) << i;
     }
 
-    throw std::out_of_range("TVector operator[]: Index out of range.");
+    for (; i < count; i++) {
+        mask |= static_cast<uint64_t>(pred(block[i])) << i;
+    }
+
+    return mask;
 }
+#endif  // TVECTOR_SSE2
 
 template<typename T>
-typename TVector<T>::const_reference
-TVector<T>::operator[](size_type index) const {
-    if (index >= _used) {
-        throw std::out_of_range("TVector operator[]: Index out of range.");
-    }
+typename std::enable_if<std::is_arithmetic<T>::value, uint64_t>::type
+match_mask(const T* block, size_t count, uint64_t busy,
+    EqualPredicate<T>& pred) {
+    return dense_mask(block, count, pred) & busy;
+}
 
-    if (_deleted == 0) {
-        return _data[index];
+template<typename T>
+typename std::enable_if<std::is_arithmetic<T>::value, uint64_t>::type
+match_mask(const T* block, size_t count, uint64_t busy,
+    RangePredicate<T>& pred) {
+    return dense_mask(block, count, pred) & busy;
+}
+
+// Walks the matches of pred in slot order, one word of the Busy bitmap at
+// a time. index() is the logical index of the current match.
+template<typename T, class Predicate>
+class MatchScanner {
+ private:
+    const T* _data;
+    const uint64_t* _busy;
+    size_t _head;
+    size_t _used;
+    Predicate* _pred;
+    size_t _word;
+    uint64_t _mask;
+    // Busy slots in the words before _word.
+    size_t _before;
+
+ public:
+    MatchScanner(const T* data, const uint64_t* busy, size_t head,
+        size_t used, Predicate* pred) : _data(data), _busy(busy), _head(head),
+        _used(used), _pred(pred), _word(head / 64), _mask(0), _before(0) {
+        load();
     }
 
-    size_type current_index = 0;
+    bool done() const noexcept { return _mask == 0; }
 
-    for (size_type i = 0; i < _used; i++) {
-        if (_states[i] == Busy) {
-            if (current_index == index)
-                return _data[i];
+    size_t index() const noexcept {
+        uint64_t below = (uint64_t(1) << lowest_bit(_mask)) - 1;
 
-            current_index++;
+        return _before + popcount(_busy[_word] & below);
+    }
+
+    void next() {
+        _mask &= _mask - 1;
+
+        if (_mask == 0) {
+            _before += popcount(_busy[_word]);
+            _word++;
+            load();
         }
     }
 
-    throw std::out_of_range("TVector operator[]: Not found.");
-}
+ private:
+    void load() {
+        size_t words = (_used + 63) / 64;
 
-template<typename T>
-void TVector<T>::reset_memory_for_delete() noexcept {
-    size_type correct_size = size();
-    size_type new_capacity =
-        (correct_size / _capacity_step + 1) * _capacity_step;
-    T* new_data = new T[new_capacity];
-    State* new_states = new State[new_capacity];
-    size_type index = 0;
+        for (; _word < words; _word++) {
+            size_t first = _word * 64;
+            size_t count = _used - first < 64 ? _used - first : 64;
 
-    for (size_type i = 0; i < _used; i++) {
-        if (_states[i] == Busy) {
-            new_data[index] = _data[i];
-            new_states[index] = Busy;
-            index++;
+            // Slots before _head are raw, test only Busy ones there.
+            if (first < _head)
+                _mask = sparse_mask(_data + first, _busy[_word], *_pred);
+            else
+                _mask = match_mask(_data + first, count, _busy[_word], *_pred);
+
+            if (_mask != 0)
+                return;
+
+            _before += popcount(_busy[_word]);
         }
-    }
 
-    for (size_type i = index; i < new_capacity; i++) {
-        new_data[i] = T();
-        new_states[i] = Empty;
+        _mask = 0;
     }
+};
+}  // namespace tvector_detail
 
-    _capacity = new_capacity;
-    _deleted = 0;
-    _used = correct_size;
-    delete[] _data;
-    delete[] _states;
-    _data = new_data;
-    _states = new_states;
-}
+// Lazy sequence of the logical indices of the elements matching a
+// predicate, nothing is allocated. Changing the vector invalidates it.
+template<typename T, class Predicate>
+class FindRange {
+ private:
+    const TVector<T>* _vec;
+    Predicate _pred;
 
-template<typename T>
-void TVector<T>::reset_memory(size_type new_size) noexcept {
-    size_type size_diff = new_size - size();
-    size_type new_capacity = (new_size / _capacity_step + 1) * _capacity_step;
-    T* new_data = new T[new_capacity];
-    State* new_states = new State[new_capacity];
-    size_type index = 0;
+ public:
+    class Iterator {
+     private:
+        tvector_detail::MatchScanner<T, Predicate> _scanner;
 
-    for (size_type i = 0; i < _used; i++) {
-        if (_states[i] == Busy) {
-            new_data[index] = _data[i];
-            new_states[index] = Busy;
-            index++;
+     public:
+        explicit Iterator(const tvector_detail::MatchScanner<T, Predicate>&
+            scanner) : _scanner(scanner) {}
+
+        size_t operator*() const noexcept { return _scanner.index(); }
+
+        Iterator& operator++() {
+            _scanner.next();
+            return *this;
+        }
+
+        // Only comparison with end() is meaningful.
+        bool operator!=(const Iterator& other) const noexcept {
+            return _scanner.done() != other._scanner.done();
         }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return !(*this != other);
+        }
+    };
+
+    FindRange(const TVector<T>& vec, Predicate pred) : _vec(&vec),
+        _pred(pred) {}
+
+    Iterator begin() {
+        return Iterator(tvector_detail::MatchScanner<T, Predicate>(
+            _vec->_data, _vec->_busy, _vec->_head, _vec->_used, &_pred));
     }
 
-    for (size_type i = index; i < new_capacity; i++) {
-        new_data[i] = T();
-        new_states[i] = Empty;
+    Iterator end() {
+        return Iterator(tvector_detail::MatchScanner<T, Predicate>(
+            _vec->_data, _vec->_busy, 0, 0, &_pred));
     }
+};
 
-    _capacity = new_capacity;
-    _deleted = 0;
-    _used = new_size - size_diff;
-    delete[] _data;
-    delete[] _states;
-    _data = new_data;
-    _states = new_states;
+// Introsort: median-of-three/ninther quicksort that falls back to heapsort
+// past 2 * log2(n) levels and finishes short ranges with insertion sort.
+template<typename U, class Compare>
+void tv_sort(TVector<U>& vec, Compare comp) {
+    vec.pack();
+    tvector_detail::introsort(vec._data, vec._data + vec._used,
+        tvector_detail::sort_depth_limit(vec._used), comp);
 }
 
-template<typename T>
-typename TVector<T>::Iterator TVector<T>::reset_memory(size_type new_size,
-    const Iterator& insert_it) noexcept {
-    size_type new_insert_index = insert_it.index();
-    reset_memory(new_size);
+template<typename U>
+void tv_sort(TVector<U>& vec) {
+    tv_sort(vec, [](const U& a, const U& b) { return a < b; });
+}
 
-    return Iterator(&_data[new_insert_index], *this);
+// Merge sort, keeps the order of equal elements.
+template<typename U, class Compare>
+void tv_stable_sort(TVector<U>& vec, Compare comp) {
+    vec.pack();
+
+    size_t buffer_size = vec._used / 2 + 1;
+    U* buffer = static_cast<U*>(vec._resource->allocate(
+        buffer_size * sizeof(U), alignof(U)));
+
+    tvector_detail::merge_sort(vec._data, vec._data + vec._used, buffer, comp);
+    vec._resource->deallocate(buffer, buffer_size * sizeof(U), alignof(U));
 }
 
-template<typename T>
-inline bool TVector<T>::is_full() const noexcept {
-    return _used == _capacity;
+template<typename U>
+void tv_stable_sort(TVector<U>& vec) {
+    tv_stable_sort(vec, [](const U& a, const U& b) { return a < b; });
 }
 
-template<typename T>
-inline void TVector<T>::swap_elem(size_type first_index, size_type second_index)
-noexcept {
-    T temp_elem = _data[first_index];
-    _data[first_index] = _data[second_index];
-    _data[second_index] = temp_elem;
+// Puts the count smallest elements in order at the front, the order of the
+// rest is unspecified.
+template<typename U, class Compare>
+void tv_partial_sort(TVector<U>& vec, size_t count, Compare comp) {
+    vec.pack();
+
+    if (count > vec._used)
+        count = vec._used;
+
+    if (count == 0)
+        return;
+
+    U* first = vec._data;
+    ptrdiff_t heap_size = static_cast<ptrdiff_t>(count);
+
+    tvector_detail::make_heap(first, heap_size, comp);
+
+    for (size_t i = count; i < vec._used; i++) {
+        if (comp(first[i], first[0])) {
+            std::swap(first[i], first[0]);
+            tvector_detail::sift_down(first, 0, heap_size, comp);
+        }
+    }
 
-    State temp_state = _states[first_index];
-    _states[first_index] = _states[second_index];
-    _states[second_index] = temp_state;
+    for (ptrdiff_t end = heap_size - 1; end > 0; end--) {
+        std::swap(first[0], first[end]);
+        tvector_detail::sift_down(first, 0, end, comp);
+    }
 }
 
-template<typename T>
-std::ostream& operator<<(std::ostream& stream, const TVector<T>& out) noexcept {
-    stream << "size(" << out._used << ") capacity(" <<
-        out._capacity << ") deleted(" << out._deleted << ") vector: [ ";
+template<typename U>
+void tv_partial_sort(TVector<U>& vec, size_t count) {
+    tv_partial_sort(vec, count, [](const U& a, const U& b) { return a < b; });
+}
 
-    size_t out_size = out.size() > 1000 ? 1000 : out.size();
+// Sorts runs of the vector on separate threads, then merges neighbouring
+// runs in rounds. Every merge is cut into pieces of equal output length, so
+// all threads stay busy up to the last round. threads == 0 means one per
+// core. The comparator is copied to each thread.
+template<typename U, class Compare>
+void tv_parallel_sort(TVector<U>& vec, Compare comp, size_t threads) {
+    vec.pack();
+
+    size_t size = vec._used;
+
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+
+    if (threads > size / tvector_detail::parallel_sort_grain)
+        threads = size / tvector_detail::parallel_sort_grain;
 
-    for (size_t i = 0; i < out_size; i++) {
-        stream << out[i] << " ";
+    if (threads < 2) {
+        tvector_detail::introsort(vec._data, vec._data + size,
+            tvector_detail::sort_depth_limit(size), comp);
+        return;
     }
 
-    stream << " ]";
+    U* data = vec._data;
+    size_t* bounds = new size_t[threads + 1];
+    tvector_detail::PhaseWorkers workers(threads);
 
-    return stream;
+    for (size_t i = 0; i <= threads; i++) {
+        bounds[i] = size * i / threads;
+    }
+
+    auto sort_run = [&](size_t i) {
+        Compare local = comp;
+        size_t run = bounds[i + 1] - bounds[i];
+
+        tvector_detail::introsort(data + bounds[i], data + bounds[i + 1],
+            tvector_detail::sort_depth_limit(run), local);
+    };
+    workers.run(threads, sort_run);
+
+    U* buffer = static_cast<U*>(vec._resource->allocate(size * sizeof(U),
+        alignof(U)));
+    U* from = data;
+    U* to = buffer;
+    bool raw = true;
+    size_t runs = threads;
+
+    while (runs > 1) {
+        size_t pairs = runs / 2;
+        size_t pieces = threads / pairs > 0 ? threads / pairs : 1;
+
+        // Split points are found before anything is moved out of from.
+        size_t* splits = new size_t[pairs * (pieces + 1)];
+
+        for (size_t pair = 0; pair < pairs; pair++) {
+            U* a = from + bounds[2 * pair];
+            U* b = from + bounds[2 * pair + 1];
+            size_t a_size = b - a;
+            size_t b_size = bounds[2 * pair + 2] - bounds[2 * pair + 1];
+
+            for (size_t piece = 0; piece <= pieces; piece++) {
+                splits[pair * (pieces + 1) + piece] =
+                    tvector_detail::merge_split(a, a_size, b, b_size,
+                        (a_size + b_size) * piece / pieces, comp);
+            }
+        }
+
+        auto merge_piece = [&](size_t task) {
+            if (task == pairs * pieces) {
+                for (size_t i = bounds[runs - 1]; i < bounds[runs]; i++) {
+                    tvector_detail::move_to(to + i, from[i], raw);
+                }
+
+                return;
+            }
+
+            Compare local = comp;
+            size_t pair = task / pieces;
+            size_t piece = task % pieces;
+            size_t first = bounds[2 * pair];
+            size_t length = bounds[2 * pair + 2] - first;
+            size_t out_begin = length * piece / pieces;
+            size_t out_end = length * (piece + 1) / pieces;
+            size_t a_begin = splits[pair * (pieces + 1) + piece];
+            size_t a_end = splits[pair * (pieces + 1) + piece + 1];
+            U* a = from + first;
+            U* b = from + bounds[2 * pair + 1];
+
+            tvector_detail::merge_move(a + a_begin, a + a_end,
+                b + (out_begin - a_begin), b + (out_end - a_end),
+                to + first + out_begin, raw, local);
+        };
+        workers.run(pairs * pieces + runs % 2, merge_piece);
+        delete[] splits;
+
+        for (size_t i = 1; i <= pairs; i++) {
+            bounds[i] = bounds[2 * i];
+        }
+
+        if (runs % 2 == 1)
+            bounds[pairs + 1] = bounds[runs];
+
+        runs = pairs + runs % 2;
+        std::swap(from, to);
+        raw = false;
+    }
+
+    if (from != data) {
+        auto move_back = [&](size_t i) {
+            for (size_t j = size * i / threads; j < size * (i + 1) / threads;
+                j++) {
+                data[j] = std::move(buffer[j]);
+            }
+        };
+        workers.run(threads, move_back);
+    }
+
+    TVector<U>::destroy(buffer, size);
+    vec._resource->deallocate(buffer, size * sizeof(U), alignof(U));
+    delete[] bounds;
+}
+
+template<typename U, class Compare>
+void tv_parallel_sort(TVector<U>& vec, Compare comp) {
+    tv_parallel_sort(vec, comp, 0);
 }
 
 template<typename U>
-void shuffle(TVector<U>& vec) noexcept {
-    std::srand(std::time(0));
+void tv_parallel_sort(TVector<U>& vec) {
+    tv_parallel_sort(vec, [](const U& a, const U& b) { return a < b; }, 0);
+}
 
-    for (size_t i = vec._used - 1; i > 0; --i) {
-        size_t j = std::rand() % (i + 1);
-        vec.swap_elem(i, j);
+// Stable LSD radix sort by key_of(element), which has to return an
+// integral or floating point key. Short vectors use the comparison sort.
+template<typename U, class KeyOf>
+void tv_radix_sort(TVector<U>& vec, KeyOf key_of) {
+    typedef tvector_detail::radix_key<
+        typename std::decay<decltype(key_of(*vec._data))>::type> key;
+
+    vec.pack();
+
+    if (vec._used <= tvector_detail::radix_sort_threshold) {
+        auto less = [&key_of](const U& a, const U& b) {
+            return key::get(key_of(a)) < key::get(key_of(b));
+        };
+        tvector_detail::insertion_sort(vec._data, vec._data + vec._used, less);
+        return;
     }
+
+    U* buffer = static_cast<U*>(vec._resource->allocate(
+        vec._used * sizeof(U), alignof(U)));
+
+    tvector_detail::lsd_radix_sort(vec._data, vec._used, buffer, key_of);
+    vec._resource->deallocate(buffer, vec._used * sizeof(U), alignof(U));
 }
 
 template<typename U>
-void quick_sort(TVector<U>& vec, size_t low, size_t high, bool(*comp)(U, U))
-noexcept {
-    if (low < high) {
-        size_t pivot_index = partition(vec, low, high, comp);
+void tv_radix_sort(TVector<U>& vec) {
+    tv_radix_sort(vec, [](const U& elem) { return elem; });
+}
 
-        if (pivot_index > low) {
-            quick_sort(vec, low, pivot_index - 1, comp);
-        }
+// MSD radix sort that needs no buffer, does not keep the order of equal
+// keys.
+template<typename U, class KeyOf>
+void tv_radix_sort_in_place(TVector<U>& vec, KeyOf key_of) {
+    typedef typename tvector_detail::radix_key<
+        typename std::decay<decltype(key_of(*vec._data))>::type>::type bits;
 
-        if (pivot_index < high) {
-            quick_sort(vec, pivot_index + 1, high, comp);
-        }
-    }
+    vec.pack();
+    tvector_detail::american_flag_sort(vec._data, vec._data + vec._used,
+        sizeof(bits) * 8 - 8, key_of);
 }
 
 template<typename U>
-size_t partition(TVector<U>& vec, size_t low, size_t high, bool(*comp)(U, U))
-noexcept {
-    size_t pivot_index = low + (high - low) / 2;
-    U pivot = vec._data[pivot_index];
-    vec.swap_elem(pivot_index, high);
+void tv_radix_sort_in_place(TVector<U>& vec) {
+    tv_radix_sort_in_place(vec, [](const U& elem) { return elem; });
+}
+
+// Logical index of the first element matching pred, TVector::npos if there
+// is none. pred is any callable taking const U&.
+template<typename U, class Predicate>
+size_t find_if(const TVector<U>& vec, Predicate pred) {
+    tvector_detail::MatchScanner<U, Predicate> scanner(vec._data, vec._busy,
+        vec._head, vec._used, &pred);
+
+    return scanner.done() ? TVector<U>::npos : scanner.index();
+}
+
+template<typename U, class Predicate>
+size_t find_last_if(const TVector<U>& vec, Predicate pred) {
+    // Busy slots in the words after the current one.
+    size_t after = 0;
+
+    for (size_t word = (vec._used + 63) / 64; word > vec._head / 64; word--) {
+        size_t first = (word - 1) * 64;
+        size_t count = vec._used - first < 64 ? vec._used - first : 64;
+        uint64_t busy = vec._busy[word - 1];
+        uint64_t mask = first < vec._head ?
+            tvector_detail::sparse_mask(vec._data + first, busy, pred) :
+            tvector_detail::match_mask(vec._data + first, count, busy, pred);
 
-    size_t i = low - 1;
+        if (mask != 0) {
+            size_t bit = tvector_detail::highest_bit(mask);
 
-    for (size_t j = low; j < high; j++) {
-        if (comp(vec._data[j], pivot)) {
-            i++;
-            vec.swap_elem(i, j);
+            return vec.size() - after - tvector_detail::popcount(busy >> bit);
         }
+
+        after += tvector_detail::popcount(busy);
     }
 
-    vec.swap_elem(i + 1, high);
+    return TVector<U>::npos;
+}
+
+// Writes the logical indices of up to capacity matching elements to out in
+// ascending order and returns how many were written.
+template<typename U, class Predicate>
+size_t find_all(const TVector<U>& vec, Predicate pred, size_t* out,
+    size_t capacity) {
+    size_t written = 0;
+
+    for (tvector_detail::MatchScanner<U, Predicate> scanner(vec._data,
+        vec._busy, vec._head, vec._used, &pred);
+        !scanner.done() && written < capacity; scanner.next()) {
+        out[written++] = scanner.index();
+    }
 
-    return i + 1;
+    return written;
 }
 
-template<typename U>
-inline void tv_sort(TVector<U>& vec, bool(*comp)(U, U)) noexcept {
-    quick_sort(vec, 0, vec._used - 1, comp);
+// for (size_t index : find_all(vec, pred)) visits the matches lazily.
+template<typename U, class Predicate>
+FindRange<U, Predicate> find_all(const TVector<U>& vec, Predicate pred) {
+    return FindRange<U, Predicate>(vec, pred);
 }
 
+// Older interface: an array of vec.size() indices the caller deletes,
+// padded with -1. find_all does the same without allocating.
 template<typename U>
 int* search_all(TVector<U>& vec, bool(*check)(U)) noexcept {
     int* search_result = new int[vec.size()];
-    int deleted_count = 0;
-    int index = 0;
-
-    for (int i = 0; i < vec._used; i++) {
-        if (vec._states[i] == Busy) {
-            if (check(vec._data[i])) {
-                search_result[index] = i - deleted_count;
-                index++;
-            }
-        } else {
-            deleted_count++;
-        }
+    size_t index = 0;
+
+    for (size_t found : find_all(vec, check)) {
+        search_result[index] = static_cast<int>(found);
+        index++;
     }
 
-    for (int i = index; i < vec.size(); i++) {
+    for (size_t i = index; i < vec.size(); i++) {
         search_result[i] = -1;
     }
 
@@ -1077,56 +3280,38 @@ int* search_all(TVector<U>& vec, bool(*check)(U)) noexcept {
 
 template<typename U>
 int search_begin(TVector<U>& vec, bool(*check)(U)) noexcept {
-    int deleted_count = 0;
-
-    for (int i = 0; i < vec._used; i++) {
-        if (vec._states[i] == Busy) {
-            if (check(vec._data[i]))
-                return i - deleted_count;
-        } else {
-            deleted_count++;
-        }
-    }
+    size_t found = find_if(vec, check);
 
-    return -1;
+    return found == TVector<U>::npos ? -1 : static_cast<int>(found);
 }
 
 template<typename U>
 int search_end(TVector<U>& vec, bool(*check)(U)) noexcept {
-    int deleted_count = 0;
+    size_t found = find_last_if(vec, check);
 
-    for (int i = vec._used - 1; i > 0; i--) {
-        if (vec._states[i] == Busy) {
-            if (check(vec._data[i]))
-                return i - (vec._deleted - deleted_count);
-        }
-    }
-
-    return -1;
+    return found == TVector<U>::npos ? -1 : static_cast<int>(found);
 }
 #pragma endregion TVectorRealization
 
 #pragma region IteratorsRealization
 template<typename T>
 TVector<T>::Iterator::Iterator(T* ptr, TVector<T>& parent) noexcept
-    : _ptr(ptr), _parent(parent) {
-}
-
-template<typename T>
-TVector<T>::Iterator::Iterator(const Iterator& other) noexcept
-    : _ptr(other._ptr), _parent(other._parent) {
+    : _ptr(ptr), _parent(&parent) {
 }
 
 template <typename T>
 inline typename TVector<T>::Iterator::reference
 TVector<T>::Iterator::operator*() {
+#if TVECTOR_CHECKED_ITERATORS
     if (_ptr == nullptr) {
         throw std::out_of_range("Iterator operator*: Nullptr.");
     }
 
-    if (_ptr < _parent._data || _ptr >= _parent._data + _parent._used) {
+    if (_ptr < _parent->_data + _parent->_head ||
+        _ptr >= _parent->_data + _parent->_used) {
         throw std::out_of_range("Iterator operator*: Index out of range.");
     }
+#endif
 
     return *_ptr;
 }
@@ -1138,25 +3323,24 @@ TVector<T>::Iterator::operator->() noexcept {
 }
 
 template<typename T>
-inline typename TVector<T>::Iterator&
-TVector<T>::Iterator::operator=(const Iterator& other) noexcept {
-    if (this != &other) {
-        _ptr = other._ptr;
-        _parent = other._parent;
+typename TVector<T>::Iterator& TVector<T>::Iterator::operator++() noexcept {
+    // Without Deleted slots the live elements are contiguous.
+    if (_parent->_deleted == 0) {
+        if (_ptr < _parent->_data + _parent->_used)
+            ++_ptr;
+
+        return *this;
     }
 
-    return *this;
-}
+    size_type current_index = _ptr - _parent->_data;
 
-template<typename T>
-typename TVector<T>::Iterator& TVector<T>::Iterator::operator++() noexcept {
-    ptrdiff_t current_index = _ptr - _parent._data;
+    if (current_index < _parent->_used) {
+        size_type next_index = _parent->next_busy(current_index + 1);
 
-    for (ptrdiff_t i = current_index + 1; i <= _parent._used; i++) {
-        if (_parent._states[i] != Deleted) {
-            _ptr = &_parent._data[i];
-            break;
-        }
+        if (next_index >= _parent->_used)
+            next_index = _parent->end_slot();
+
+        _ptr = &_parent->_data[next_index];
     }
 
     return *this;
@@ -1173,13 +3357,17 @@ noexcept {
 
 template<typename T>
 typename TVector<T>::Iterator& TVector<T>::Iterator::operator--() noexcept {
-    ptrdiff_t current_index = _ptr - _parent._data;
+    if (_parent->_deleted == 0) {
+        if (_ptr > _parent->_data + _parent->_head)
+            --_ptr;
 
-    for (ptrdiff_t i = current_index - 1; i >= 0; i--) {
-        if (_parent._states[i] != Deleted) {
-            _ptr = &_parent._data[i];
-            break;
-        }
+        return *this;
+    }
+
+    size_type prev_index = _parent->prev_busy(_ptr - _parent->_data);
+
+    if (prev_index != npos) {
+        _ptr = &_parent->_data[prev_index];
     }
 
     return *this;
@@ -1195,80 +3383,66 @@ noexcept {
 
 template<typename T>
 typename TVector<T>::Iterator TVector<T>::Iterator::operator+(int num) const {
-    int new_index = _ptr - _parent._data;
-
-    if (new_index + num > _parent._used || new_index + num < 0) {
-        throw std::out_of_range("Iterator operator+: Index out of range.");
-    }
+    Iterator result = *this;
+    result += num;
 
-    while (new_index < _parent._used && num > 0) {
-        new_index++;
-
-        if (_parent._states[new_index] != Deleted) {
-            num--;
-        }
-    }
-
-    return Iterator(&_parent._data[new_index], _parent);
+    return result;
 }
 
 template<typename T>
 typename TVector<T>::Iterator TVector<T>::Iterator::operator-(int num) const {
-    int new_index = _ptr - _parent._data;
-
-    if (new_index - num > _parent._used || new_index - num < 0) {
-        throw std::out_of_range("Iterator operator-: Index out of range.");
-    }
-
-    while (new_index > 0 && num > 0) {
-        new_index--;
+    Iterator result = *this;
+    result -= num;
 
-        if (_parent._states[new_index] != Deleted) {
-            num--;
-        }
-    }
-
-    return Iterator(&_parent._data[new_index], _parent);
+    return result;
 }
 
 template<typename T>
 typename TVector<T>::Iterator& TVector<T>::Iterator::operator+=(int num) {
-    int new_index = _ptr - _parent._data;
+    difference_type new_index = _ptr - _parent->_data;
 
-    if (new_index + num > _parent._used || new_index + num < 0) {
+    if (new_index + num > static_cast<difference_type>(_parent->_used) ||
+        new_index + num < 0) {
         throw std::out_of_range("Iterator operator+: Index out of range.");
     }
 
-    while (new_index < _parent._used && num > 0) {
-        new_index++;
+    if (num > 0 && _parent->_deleted == 0) {
+        new_index += num;
+    } else if (num > 0) {
+        new_index = _parent->select_from(new_index + 1, num - 1);
 
-        if (_parent._states[new_index] != Deleted) {
-            num--;
-        }
+        if (new_index >= static_cast<difference_type>(_parent->_used))
+            new_index = _parent->end_slot();
     }
 
-    _ptr = &_parent._data[new_index];
+    _ptr = &_parent->_data[new_index];
 
     return *this;
 }
 
 template<typename T>
 typename TVector<T>::Iterator& TVector<T>::Iterator::operator-=(int num) {
-    int new_index = _ptr - _parent._data;
+    difference_type new_index = _ptr - _parent->_data;
 
-    if (new_index - num > _parent._used || new_index - num < 0) {
+    if (new_index - num > static_cast<difference_type>(_parent->_used) ||
+        new_index - num < 0) {
         throw std::out_of_range("Iterator operator-: Index out of range.");
     }
 
-    while (new_index >= 0 && num > 0) {
-        new_index--;
+    if (num > 0) {
+        size_type prev_index = _parent->select_before(new_index, num - 1);
 
-        if (_parent._states[new_index] != Deleted) {
-            num--;
+        // Fewer than num elements before, the slot bound above counts the
+        // front room and the Deleted slots as well.
+        if (prev_index == npos) {
+            throw std::out_of_range("Iterator operator-: Index out of"
+                " range.");
         }
+
+        new_index = prev_index;
     }
 
-    _ptr = &_parent._data[new_index];
+    _ptr = &_parent->_data[new_index];
 
     return *this;
 }
@@ -1276,43 +3450,44 @@ typename TVector<T>::Iterator& TVector<T>::Iterator::operator-=(int num) {
 template<typename T>
 inline bool TVector<T>::Iterator::operator!=(const Iterator& other)
 const noexcept {
-    return _ptr != other._ptr || &_parent != &other._parent;
+#if TVECTOR_CHECKED_ITERATORS
+    return _ptr != other._ptr || _parent != other._parent;
+#else
+    return _ptr != other._ptr;
+#endif
 }
 
 template<typename T>
 inline bool TVector<T>::Iterator::operator==(const Iterator& other)
 const noexcept {
-    return _ptr == other._ptr && &_parent == &other._parent;
+#if TVECTOR_CHECKED_ITERATORS
+    return _ptr == other._ptr && _parent == other._parent;
+#else
+    return _ptr == other._ptr;
+#endif
 }
 
 template<typename T>
 typename TVector<T>::Iterator::difference_type
 TVector<T>::Iterator::operator-(const Iterator& other) const {
-    if (&_parent != &other._parent)
+    if (_parent != other._parent)
         throw std::runtime_error("Iterator operator-: Different parents");
 
-    int reverse = _ptr < other._ptr ? -1 : 1;
-    Iterator left = _ptr < other._ptr ? *this : other;
-    Iterator right = _ptr > other._ptr ? *this : other;
-
-    ptrdiff_t distance = 0;
-    T* current = left._ptr;
-
-    while (current != right._ptr) {
-        if (_parent._states[current - _parent._data] != Deleted) {
-            distance++;
-        }
+    if (_parent->_deleted == 0)
+        return _ptr - other._ptr;
 
-        current++;
+    if (_ptr < other._ptr) {
+        return -static_cast<difference_type>(_parent->count_busy(index(),
+            other.index()));
     }
 
-    return distance * reverse;
+    return _parent->count_busy(other.index(), index());
 }
 
 template<typename T>
 inline typename TVector<T>::Iterator::difference_type
 TVector<T>::Iterator::index() const noexcept {
-    return _ptr - _parent._data;
+    return _ptr - _parent->_data;
 }
 
 template<typename T>
@@ -1342,20 +3517,13 @@ TVector<T>::Iterator::operator[](difference_type n) {
         throw std::out_of_range("Negative index not allowed");
     }
 
-    Iterator tmp = *this;
-    difference_type count = 0;
+    size_type slot = _parent->select_from(index(), n);
 
-    while (tmp != _parent.end()) {
-        if (_parent._states[tmp.index()] == Busy) {
-            if (count == n) {
-                return *tmp;
-            }
-            count++;
-        }
-        ++tmp;
+    if (slot >= _parent->_used) {
+        throw std::runtime_error("Element not found");
     }
 
-    throw std::runtime_error("Element not found");
+    return _parent->_data[slot];
 }
 #pragma endregion
 
@@ -1364,24 +3532,22 @@ TVector<T>::Iterator::operator[](difference_type n) {
 template<typename T>
 TVector<T>::ConstIterator::ConstIterator(const T* ptr,
     const TVector<T>& parent)noexcept
-    : _ptr(ptr), _parent(parent) {
-}
-
-template<typename T>
-TVector<T>::ConstIterator::ConstIterator(const ConstIterator& other) noexcept
-    : _ptr(other._ptr), _parent(other._parent) {
+    : _ptr(ptr), _parent(&parent) {
 }
 
 template <typename T>
 inline typename TVector<T>::ConstIterator::reference
 TVector<T>::ConstIterator::operator*() {
+#if TVECTOR_CHECKED_ITERATORS
     if (_ptr == nullptr) {
         throw std::out_of_range("ConstIterator operator*: Nullptr.");
     }
 
-    if (_ptr < _parent._data || _ptr >= _parent._data + _parent._used) {
+    if (_ptr < _parent->_data + _parent->_head ||
+        _ptr >= _parent->_data + _parent->_used) {
         throw std::out_of_range("ConstIterator operator*: Index out of range.");
     }
+#endif
 
     return *_ptr;
 }
@@ -1395,13 +3561,23 @@ TVector<T>::ConstIterator::operator->() noexcept {
 template<typename T>
 typename TVector<T>::ConstIterator&
 TVector<T>::ConstIterator::operator++() noexcept {
-    difference_type current_index = _ptr - _parent._data;
+    // Without Deleted slots the live elements are contiguous.
+    if (_parent->_deleted == 0) {
+        if (_ptr < _parent->_data + _parent->_used)
+            ++_ptr;
 
-    for (difference_type i = current_index + 1; i <= _parent._used; i++) {
-        if (_parent._states[i] != Deleted) {
-            _ptr = &_parent._data[i];
-            break;
-        }
+        return *this;
+    }
+
+    size_type current_index = _ptr - _parent->_data;
+
+    if (current_index < _parent->_used) {
+        size_type next_index = _parent->next_busy(current_index + 1);
+
+        if (next_index >= _parent->_used)
+            next_index = _parent->end_slot();
+
+        _ptr = &_parent->_data[next_index];
     }
 
     return *this;
@@ -1419,13 +3595,17 @@ TVector<T>::ConstIterator::operator++(int) noexcept {
 template<typename T>
 typename TVector<T>::ConstIterator&
 TVector<T>::ConstIterator::operator--() noexcept {
-    difference_type current_index = _ptr - _parent._data;
+    if (_parent->_deleted == 0) {
+        if (_ptr > _parent->_data + _parent->_head)
+            --_ptr;
 
-    for (difference_type i = current_index - 1; i >= 0; i--) {
-        if (_parent._states[i] != Deleted) {
-            _ptr = &_parent._data[i];
-            break;
-        }
+        return *this;
+    }
+
+    size_type prev_index = _parent->prev_busy(_ptr - _parent->_data);
+
+    if (prev_index != npos) {
+        _ptr = &_parent->_data[prev_index];
     }
 
     return *this;
@@ -1442,61 +3622,41 @@ TVector<T>::ConstIterator::operator--(int) noexcept {
 template<typename T>
 typename TVector<T>::ConstIterator
 TVector<T>::ConstIterator::operator+(int num) const {
-    int new_index = _ptr - _parent._data;
-
-    if (new_index + num > _parent._used || new_index + num < 0) {
-        throw std::out_of_range("ConstIterator operator+: Index out of range.");
-    }
-
-    while (new_index < _parent._used && num > 0) {
-        new_index++;
-
-        if (_parent._states[new_index] != Deleted) {
-            num--;
-        }
-    }
+    ConstIterator result = *this;
+    result += num;
 
-    return ConstIterator(&_parent._data[new_index], _parent);
+    return result;
 }
 
 template<typename T>
 typename TVector<T>::ConstIterator
 TVector<T>::ConstIterator::operator-(int num) const {
-    int new_index = _ptr - _parent._data;
+    ConstIterator result = *this;
+    result -= num;
 
-    if (new_index - num > _parent._used || new_index - num < 0) {
-        throw std::out_of_range("ConstIterator operator-: Index out of range.");
-    }
-
-    while (new_index > 0 && num > 0) {
-        new_index--;
-
-        if (_parent._states[new_index] != Deleted) {
-            num--;
-        }
-    }
-
-    return ConstIterator(&_parent._data[new_index], _parent);
+    return result;
 }
 
 template<typename T>
 typename TVector<T>::ConstIterator&
 TVector<T>::ConstIterator::operator+=(int num) {
-    int new_index = _ptr - _parent._data;
+    difference_type new_index = _ptr - _parent->_data;
 
-    if (new_index + num > _parent._used || new_index + num < 0) {
+    if (new_index + num > static_cast<difference_type>(_parent->_used) ||
+        new_index + num < 0) {
         throw std::out_of_range("ConstIterator operator+: Index out of range.");
     }
 
-    while (new_index < _parent._used && num > 0) {
-        new_index++;
+    if (num > 0 && _parent->_deleted == 0) {
+        new_index += num;
+    } else if (num > 0) {
+        new_index = _parent->select_from(new_index + 1, num - 1);
 
-        if (_parent._states[new_index] != Deleted) {
-            num--;
-        }
+        if (new_index >= static_cast<difference_type>(_parent->_used))
+            new_index = _parent->end_slot();
     }
 
-    _ptr = &_parent._data[new_index];
+    _ptr = &_parent->_data[new_index];
 
     return *this;
 }
@@ -1504,21 +3664,27 @@ TVector<T>::ConstIterator::operator+=(int num) {
 template<typename T>
 typename TVector<T>::ConstIterator&
 TVector<T>::ConstIterator::operator-=(int num) {
-    int new_index = _ptr - _parent._data;
+    difference_type new_index = _ptr - _parent->_data;
 
-    if (new_index - num > _parent._used || new_index - num < 0) {
+    if (new_index - num > static_cast<difference_type>(_parent->_used) ||
+        new_index - num < 0) {
         throw std::out_of_range("ConstIterator operator-: Index out of range.");
     }
 
-    while (new_index >= 0 && num > 0) {
-        new_index--;
+    if (num > 0) {
+        size_type prev_index = _parent->select_before(new_index, num - 1);
 
-        if (_parent._states[new_index] != Deleted) {
-            num--;
+        // Fewer than num elements before, the slot bound above counts the
+        // front room and the Deleted slots as well.
+        if (prev_index == npos) {
+            throw std::out_of_range("ConstIterator operator-: Index out of"
+                " range.");
         }
+
+        new_index = prev_index;
     }
 
-    _ptr = &_parent._data[new_index];
+    _ptr = &_parent->_data[new_index];
 
     return *this;
 }
@@ -1526,48 +3692,49 @@ TVector<T>::ConstIterator::operator-=(int num) {
 template<typename T>
 inline bool TVector<T>::ConstIterator::operator!=(const ConstIterator& other)
 const noexcept {
-    return _ptr != other._ptr || &_parent != &other._parent;
+#if TVECTOR_CHECKED_ITERATORS
+    return _ptr != other._ptr || _parent != other._parent;
+#else
+    return _ptr != other._ptr;
+#endif
 }
 
 template<typename T>
 inline bool TVector<T>::ConstIterator::operator==(const ConstIterator& other)
 const noexcept {
-    return _ptr == other._ptr && &_parent == &other._parent;
+#if TVECTOR_CHECKED_ITERATORS
+    return _ptr == other._ptr && _parent == other._parent;
+#else
+    return _ptr == other._ptr;
+#endif
 }
 
 template<typename T>
 typename TVector<T>::ConstIterator::difference_type
 TVector<T>::ConstIterator::operator-(const ConstIterator& other) const {
-    if (&_parent != &other._parent)
+    if (_parent != other._parent)
         throw std::runtime_error("ConstIterator operator-: Different parents");
 
-    int reverse = _ptr < other._ptr ? -1 : 1;
-    ConstIterator left = _ptr < other._ptr ? *this : other;
-    ConstIterator right = _ptr > other._ptr ? *this : other;
-
-    difference_type distance = 0;
-    pointer current = left._ptr;
-
-    while (current != right._ptr) {
-        if (_parent._states[current - _parent._data] != Deleted) {
-            distance++;
-        }
+    if (_parent->_deleted == 0)
+        return _ptr - other._ptr;
 
-        current++;
+    if (_ptr < other._ptr) {
+        return -static_cast<difference_type>(_parent->count_busy(index(),
+            other.index()));
     }
 
-    return distance * reverse;
+    return _parent->count_busy(other.index(), index());
 }
 
 template<typename T>
 inline typename TVector<T>::ConstIterator::difference_type
 TVector<T>::ConstIterator::index() const noexcept {
-    return _ptr - _parent._data;
+    return _ptr - _parent->_data;
 }
 
 template<typename T>
 bool TVector<T>::ConstIterator::operator<(const ConstIterator& other)
-    const noexcept {
+const noexcept {
     return _ptr < other._ptr;
 }
 
@@ -1596,21 +3763,13 @@ TVector<T>::ConstIterator::operator[](difference_type n) {
         throw std::out_of_range("Negative index not allowed");
     }
 
-    ConstIterator tmp = *this;
-    difference_type count = 0;
-
-    while (tmp != _parent.end()) {
-        if (_parent._states[tmp.index()] == Busy) {
-            if (count == n) {
-                return *tmp;
-            }
-            count++;
-        }
+    size_type slot = _parent->select_from(index(), n);
 
-        ++tmp;
+    if (slot >= _parent->_used) {
+        throw std::runtime_error("Element not found");
     }
 
-    throw std::runtime_error("Element not found");
+    return _parent->_data[slot];
 }
 
 #pragma endregion ConstIteratorRealisation
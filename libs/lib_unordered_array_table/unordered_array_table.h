@@ -7,6 +7,7 @@
 #include <string>
 
 #include "libs/lib_itable/itable.h"
+#include "libs/lib_memory_resource/memory_resource.h"
 #include "libs/lib_tvector/tvector.h"
 
 template <typename Key, typename Value>
@@ -16,6 +17,7 @@ class UnorderedArrayTable : public ITable<Key, Value>{
 
  public:
     UnorderedArrayTable() = default;
+    explicit UnorderedArrayTable(MemoryResource* resource);
     ~UnorderedArrayTable() override = default;
 
     void insert(const Key& key, const Value& value) override;
@@ -27,6 +29,10 @@ class UnorderedArrayTable : public ITable<Key, Value>{
     std::string to_string() const override;
 };
 
+template<typename Key, typename Value>
+UnorderedArrayTable<Key, Value>::
+UnorderedArrayTable(MemoryResource* resource) : rows(resource) {}
+
 template<typename Key, typename Value>
 void UnorderedArrayTable<Key, Value>::
 insert(const Key& key, const Value& value) {
@@ -38,7 +44,7 @@ insert(const Key& key, const Value& value) {
         }
     }
 
-    rows.push_back(std::pair<Key, Value>(key, value));
+    rows.emplace_back(key, value);
 }
 
 template<typename Key, typename Value>
@@ -0,0 +1,115 @@
+// Copyright 2026 Chernykh Valentin
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "libs/lib_concurrent_tvector/concurrent_tvector.h"
+
+TEST(TestConcurrentTVector, PushReturnsIndices) {
+    ConcurrentTVector<std::string> vec;
+
+    EXPECT_EQ(0, vec.push_back("a"));
+    EXPECT_EQ(1, vec.emplace_back(3, 'b'));
+    EXPECT_EQ(2, vec.size());
+    EXPECT_EQ("a", vec[0]);
+    EXPECT_EQ("bbb", vec.at(1));
+    EXPECT_FALSE(vec.is_published(2));
+    EXPECT_THROW(vec.at(2), std::out_of_range);
+}
+
+TEST(TestConcurrentTVector, ElementsNeverMove) {
+    ConcurrentTVector<int> vec;
+
+    vec.push_back(42);
+    const int* first = &vec[0];
+
+    for (int i = 1; i < 100000; i++) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(first, &vec[0]);
+    EXPECT_EQ(42, *first);
+    EXPECT_EQ(99999, vec[99999]);
+}
+
+TEST(TestConcurrentTVector, ConcurrentPushKeepsEveryElement) {
+    const int threads = 8;
+    const int per_thread = 20000;
+    ConcurrentTVector<int> vec;
+    std::vector<std::thread> writers;
+    std::atomic<int> mismatches(0);
+
+    for (int t = 0; t < threads; t++) {
+        writers.emplace_back([&vec, &mismatches, t, per_thread]() {
+            for (int i = 0; i < per_thread; i++) {
+                size_t index = vec.push_back(t * per_thread + i);
+
+                if (vec.at(index) != t * per_thread + i)
+                    mismatches++;
+            }
+        });
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    std::vector<bool> seen(threads * per_thread, false);
+
+    EXPECT_EQ(0, mismatches.load());
+    ASSERT_EQ(threads * per_thread, vec.size());
+
+    for (size_t i = 0; i < vec.size(); i++) {
+        ASSERT_FALSE(seen[vec[i]]);
+        seen[vec[i]] = true;
+    }
+}
+
+class SegmentCountingResource : public MemoryResource {
+ public:
+    std::atomic<int> live{0};
+
+    void* allocate(size_t bytes, size_t alignment) override {
+        void* ptr = new_delete_resource()->allocate(bytes, alignment);
+        live++;
+        return ptr;
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment)
+        noexcept override {
+        live--;
+        new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+};
+
+TEST(TestConcurrentTVector, LosingSegmentCopiesAreFreed) {
+    const int threads = 8;
+    const int per_thread = 5000;
+    SegmentCountingResource counting;
+    std::vector<std::thread> writers;
+
+    {
+        ConcurrentTVector<int> vec(&counting);
+
+        for (int t = 0; t < threads; t++) {
+            writers.emplace_back([&vec, per_thread]() {
+                for (int i = 0; i < per_thread; i++) {
+                    vec.push_back(i);
+                }
+            });
+        }
+
+        for (auto& writer : writers) {
+            writer.join();
+        }
+
+        // 40000 elements end in segment 11, every losing copy is freed.
+        EXPECT_EQ(threads * per_thread, vec.size());
+        EXPECT_EQ(12, counting.live.load());
+    }
+
+    EXPECT_EQ(0, counting.live.load());
+}
@@ -0,0 +1,82 @@
+// Copyright 2026 Chernykh Valentin
+
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include "libs/lib_copy_on_write/copy_on_write.h"
+#include "libs/lib_matrix/matrix.h"
+#include "libs/lib_mvector/mvector.h"
+#include "libs/lib_tvector/tvector.h"
+
+Matrix<int> sum_of_rows_stage(CopyOnWrite<Matrix<int>> matrix) {
+    Matrix<int> result(1, matrix->cols());
+
+    for (size_t i = 0; i < matrix->rows(); i++) {
+        for (size_t j = 0; j < matrix->cols(); j++) {
+            result[0][j] += (*matrix)[i][j];
+        }
+    }
+
+    return result;
+}
+
+TEST(TestCopyOnWrite, CopiesShareTheValue) {
+    CopyOnWrite<TVector<int>> first(TVector<int>({ 1, 2, 3 }));
+    CopyOnWrite<TVector<int>> second = first;
+
+    EXPECT_EQ(2, first.use_count());
+    EXPECT_TRUE(second.is_shared());
+    EXPECT_EQ(&first.read(), &second.read());
+    EXPECT_EQ(3, second->size());
+}
+
+TEST(TestCopyOnWrite, WriteDetachesSharedValue) {
+    CopyOnWrite<TVector<std::string>> first(TVector<std::string>({ "a" }));
+    CopyOnWrite<TVector<std::string>> second(first);
+
+    second.write().push_back("b");
+
+    EXPECT_FALSE(first.is_shared());
+    EXPECT_FALSE(second.is_shared());
+    EXPECT_EQ(1, first->size());
+    EXPECT_EQ(2, second->size());
+    EXPECT_EQ("b", (*second)[1]);
+}
+
+TEST(TestCopyOnWrite, UniqueWriteDoesNotCopy) {
+    CopyOnWrite<MVector<double>> vec(MVector<double>({ 1.0, 2.0 }));
+    const MVector<double>* before = &vec.read();
+
+    vec.write()[0] = 5.0;
+
+    EXPECT_EQ(before, &vec.read());
+    EXPECT_DOUBLE_EQ(5.0, vec.read()[0]);
+}
+
+TEST(TestCopyOnWrite, AssignmentAndMove) {
+    CopyOnWrite<Matrix<int>> first(Matrix<int>({ { 1, 2 }, { 3, 4 } }));
+    CopyOnWrite<Matrix<int>> second;
+    CopyOnWrite<Matrix<int>> third;
+
+    second = first;
+    EXPECT_EQ(2, first.use_count());
+
+    third = std::move(second);
+    EXPECT_EQ(2, first.use_count());
+    EXPECT_EQ(0, second.use_count());
+
+    third = third;
+    EXPECT_EQ(2, third.use_count());
+
+    second = CopyOnWrite<Matrix<int>>(Matrix<int>(1, 1));
+    EXPECT_EQ(1, second->rows());
+}
+
+TEST(TestCopyOnWrite, ReadOnlyStagesShareTheMatrix) {
+    CopyOnWrite<Matrix<int>> input(Matrix<int>({ { 1, 2 }, { 3, 4 } }));
+    Matrix<int> expected = { { 4, 6 } };
+
+    EXPECT_EQ(expected, sum_of_rows_stage(input));
+    EXPECT_EQ(expected, sum_of_rows_stage(input));
+    EXPECT_EQ(1, input.use_count());
+}
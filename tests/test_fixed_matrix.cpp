@@ -0,0 +1,50 @@
+// Copyright 2026 Chernykh Valentin
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "libs/lib_fixed_matrix/fixed_matrix.h"
+
+TEST(TestFixedMatrix, default_init_is_zero) {
+    FixedMatrix<int, 2, 3> matrix;
+
+    EXPECT_EQ(2, matrix.rows());
+    EXPECT_EQ(3, matrix.cols());
+    EXPECT_EQ(0, matrix[1][2]);
+}
+
+TEST(TestFixedMatrix, list_init_checks_shape) {
+    ASSERT_ANY_THROW((FixedMatrix<int, 2, 2>{ { 1, 2 } }));
+    ASSERT_ANY_THROW((FixedMatrix<int, 2, 2>{ { 1, 2 }, { 3 } }));
+}
+
+TEST(TestFixedMatrix, constexpr_product) {
+    constexpr FixedMatrix<int, 2, 3> a = { { 1, 2, 3 }, { 4, 5, 6 } };
+    constexpr FixedMatrix<int, 3, 2> b = { { 7, 8 }, { 9, 10 }, { 11, 12 } };
+    constexpr FixedMatrix<int, 2, 2> product = a * b;
+    constexpr FixedMVector<int, 2> column = a * FixedMVector<int, 3>{1, 0, 1};
+
+    static_assert(product == FixedMatrix<int, 2, 2>{ { 58, 64 },
+        { 139, 154 } }, "product");
+    static_assert(column == FixedMVector<int, 2>{4, 10}, "column");
+    EXPECT_EQ(154, product[1][1]);
+}
+
+TEST(TestFixedMatrix, elementwise_and_transpose) {
+    constexpr FixedMatrix<int, 2, 2> a = { { 1, 2 }, { 3, 4 } };
+    constexpr FixedMatrix<int, 2, 2> expected = { { 3, 4 }, { 6, 9 } };
+    FixedMatrix<int, 2, 2> result = a * 2 + FixedMatrix<int, 2, 2>::identity()
+        - a.transpose() + a.transpose() / 1;
+
+    EXPECT_EQ(expected, result);
+    ASSERT_ANY_THROW(result /= 0);
+}
+
+TEST(TestFixedMatrix, converts_to_and_from_matrix) {
+    FixedMatrix<int, 2, 2> fixed = { { 1, 2 }, { 3, 4 } };
+    Matrix<int> dynamic = fixed;
+    Matrix<int> expected = { { 1, 2 }, { 3, 4 } };
+
+    EXPECT_EQ(expected, dynamic);
+    EXPECT_EQ(fixed, (FixedMatrix<int, 2, 2>(dynamic)));
+    ASSERT_ANY_THROW((FixedMatrix<int, 3, 2>(dynamic)));
+}
@@ -0,0 +1,68 @@
+// Copyright 2026 Chernykh Valentin
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "libs/lib_fixed_mvector/fixed_mvector.h"
+
+#define EPSILON 0.000001
+
+TEST(TestFixedMVector, default_init_is_zero) {
+    FixedMVector<int, 3> vec;
+
+    EXPECT_EQ(3, vec.size());
+    EXPECT_EQ(0, vec[0]);
+    EXPECT_EQ(0, vec[2]);
+}
+
+TEST(TestFixedMVector, list_init) {
+    FixedMVector<int, 4> vec = {1, 2};
+
+    EXPECT_EQ(1, vec[0]);
+    EXPECT_EQ(2, vec[1]);
+    EXPECT_EQ(0, vec[3]);
+    ASSERT_ANY_THROW((FixedMVector<int, 2>{1, 2, 3}));
+}
+
+TEST(TestFixedMVector, constexpr_arithmetic) {
+    constexpr FixedMVector<int, 3> vec_1 = {1, 2, 3};
+    constexpr FixedMVector<int, 3> vec_2 = {4, 5, 6};
+    constexpr FixedMVector<int, 3> sum = vec_1 + vec_2 * 2 - vec_1 / 1;
+    constexpr int dot = vec_1 * vec_2;
+
+    static_assert(sum == FixedMVector<int, 3>{8, 10, 12}, "sum");
+    static_assert(dot == 32, "dot");
+    EXPECT_EQ(32, dot);
+}
+
+TEST(TestFixedMVector, compound_operators) {
+    FixedMVector<double, 2> vec = {3.0, 4.0};
+
+    vec += FixedMVector<double, 2>{1.0, 1.0};
+    vec -= FixedMVector<double, 2>{1.0, 1.0};
+    vec *= 2.0;
+    vec /= 2.0;
+
+    EXPECT_NEAR(5.0, vec.length(), EPSILON);
+    EXPECT_NEAR(1.0, vec.normalized().length(), EPSILON);
+    ASSERT_ANY_THROW(vec /= 0.0);
+}
+
+TEST(TestFixedMVector, converts_to_and_from_mvector) {
+    FixedMVector<int, 3> fixed = {1, 2, 3};
+    MVector<int> dynamic = fixed;
+    MVector<int> expected = {1, 2, 3};
+
+    EXPECT_EQ(expected, dynamic);
+    EXPECT_EQ(fixed, (FixedMVector<int, 3>(dynamic)));
+    ASSERT_ANY_THROW((FixedMVector<int, 2>(dynamic)));
+}
+
+TEST(TestFixedMVector, nested_init) {
+    constexpr FixedMVector<FixedMVector<int, 2>, 2> table = {
+        {1, 2},
+        {3, 4}
+    };
+
+    static_assert(table[1][0] == 3, "nested");
+    EXPECT_EQ(4, table[1][1]);
+}
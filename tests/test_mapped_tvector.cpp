@@ -0,0 +1,160 @@
+// Copyright 2026 Chernykh Valentin
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "libs/lib_mapped_tvector/mapped_tvector.h"
+
+// Removes the file before and after the test
+class TempFile {
+ public:
+    std::string path;
+
+    explicit TempFile(const std::string& name) : path(name) {
+        std::remove(path.c_str());
+    }
+
+    ~TempFile() {
+        std::remove(path.c_str());
+    }
+};
+
+struct Sample {
+    int id;
+    double value;
+};
+
+TEST(TestMappedTVector, CreatesEmpty) {
+    TempFile file("mapped_tvector_empty.bin");
+    MappedTVector<int> vec(file.path);
+
+    EXPECT_EQ(0, vec.size());
+    EXPECT_TRUE(vec.is_empty());
+    EXPECT_EQ(vec.begin(), vec.end());
+    EXPECT_THROW(vec.pop_back(), std::runtime_error);
+    EXPECT_THROW(vec[0], std::out_of_range);
+}
+
+TEST(TestMappedTVector, ReopenKeepsElements) {
+    TempFile file("mapped_tvector_reopen.bin");
+
+    {
+        MappedTVector<Sample> vec(file.path);
+
+        for (int i = 0; i < 1000; i++) {
+            vec.push_back({ i, i * 0.5 });
+        }
+
+        vec.pop_back();
+        vec.flush();
+    }
+
+    MappedTVector<Sample> reopened(file.path);
+
+    EXPECT_EQ(999, reopened.size());
+    EXPECT_EQ(998, reopened.back().id);
+    EXPECT_DOUBLE_EQ(250.0, reopened[500].value);
+
+    reopened.push_back({ -1, 0.0 });
+    EXPECT_EQ(-1, reopened.back().id);
+}
+
+TEST(TestMappedTVector, GrowsGeometrically) {
+    TempFile file("mapped_tvector_grow.bin");
+    MappedTVector<int> vec(file.path);
+    size_t remaps = 0;
+    size_t capacity = vec.capacity();
+
+    for (int i = 0; i < 100000; i++) {
+        vec.push_back(i);
+
+        if (vec.capacity() != capacity) {
+            capacity = vec.capacity();
+            remaps++;
+        }
+    }
+
+    int64_t sum = 0;
+
+    for (int elem : vec) {
+        sum += elem;
+    }
+
+    EXPECT_LT(remaps, 20);
+    EXPECT_EQ(int64_t(4999950000), sum);
+}
+
+TEST(TestMappedTVector, AppendResizeAndShrink) {
+    TempFile file("mapped_tvector_resize.bin");
+    MappedTVector<int> vec(file.path);
+    int values[] = { 1, 2, 3 };
+
+    vec.append(values, values + 3);
+    vec.resize(5);
+    EXPECT_EQ(3, vec[2]);
+    EXPECT_EQ(0, vec[4]);
+
+    vec.reserve(1000);
+    EXPECT_LE(1000, vec.capacity());
+
+    vec.shrink_to_fit();
+    EXPECT_EQ(5, vec.capacity());
+
+    vec.clear();
+    vec.resize(2);
+    EXPECT_EQ(0, vec[0]);
+    EXPECT_EQ(0, vec[1]);
+}
+
+TEST(TestMappedTVector, MoveKeepsMapping) {
+    TempFile file("mapped_tvector_move.bin");
+    MappedTVector<int> vec(file.path);
+
+    vec.push_back(7);
+
+    MappedTVector<int> moved(std::move(vec));
+
+    EXPECT_EQ(0, vec.size());
+    EXPECT_EQ(7, moved.front());
+}
+
+TEST(TestMappedTVector, MovedFromCanBeCleared) {
+    TempFile file("mapped_tvector_moved_from.bin");
+    MappedTVector<int> vec(file.path);
+
+    vec.push_back(7);
+
+    MappedTVector<int> moved(std::move(vec));
+    const MappedTVector<int>& view = vec;
+
+    vec.clear();
+
+    EXPECT_TRUE(vec.is_empty());
+    EXPECT_TRUE(vec.begin() == vec.end());
+    EXPECT_TRUE(view.begin() == view.end());
+    EXPECT_THROW(vec.front(), std::runtime_error);
+    EXPECT_EQ(1, moved.size());
+}
+
+TEST(TestMappedTVector, RejectsForeignFiles) {
+    TempFile text("mapped_tvector_text.bin");
+    TempFile doubles("mapped_tvector_doubles.bin");
+
+    {
+        std::ofstream out(text.path);
+        out << "this is not a vector, just some text that is long enough "
+            "to hold a header";
+    }
+
+    {
+        MappedTVector<double> vec(doubles.path);
+        vec.push_back(1.0);
+    }
+
+    EXPECT_THROW(MappedTVector<int> vec(text.path), std::runtime_error);
+    EXPECT_THROW(MappedTVector<int> vec(doubles.path), std::runtime_error);
+}
@@ -1,7 +1,9 @@
 // Copyright 2025 Chernykh Valentin
 
 #include <gtest/gtest.h>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include "libs/lib_matrix/matrix.h"
 
 #define EPSILON 0.000001
@@ -46,6 +48,22 @@ TEST(TestMatrix, copy_init) {
     EXPECT_EQ(3, matrix_2.cols());
 }
 
+TEST(TestMatrix, move_init) {
+    Matrix<int> matrix_1 = {
+        {1, 2, 3},
+        {4, 5, 6}
+    };
+    const int* row = matrix_1[1].data();
+
+    Matrix<int> matrix_2(std::move(matrix_1));
+
+    EXPECT_EQ(2, matrix_2.rows());
+    EXPECT_EQ(3, matrix_2.cols());
+    EXPECT_EQ(row, matrix_2[1].data());
+    EXPECT_EQ(0, matrix_1.rows());
+    EXPECT_EQ(0, matrix_1.cols());
+}
+
 TEST(TestMatrix, access_operator) {
     Matrix<int> matrix = {
         {1, 2, 3},
@@ -245,6 +263,20 @@ TEST(TestMatrix, assignment_self_assignment) {
     EXPECT_EQ(&matrix, &assigned_ref);
 }
 
+TEST(TestMatrix, move_assignment) {
+    Matrix<int> matrix_1 = {
+        {1, 2},
+        {3, 4}
+    };
+    Matrix<int> matrix_2(3, 3);
+
+    matrix_2 = std::move(matrix_1);
+
+    EXPECT_EQ(Matrix<int>({ {1, 2}, {3, 4} }), matrix_2);
+    EXPECT_EQ(0, matrix_1.rows());
+    EXPECT_EQ(0, matrix_1.cols());
+}
+
 TEST(TestMatrix, assignment_chained) {
     Matrix<int> matrix_A(1, 1);
     Matrix<int> matrix_B(1, 1);
@@ -634,3 +666,106 @@ TEST(TestMatrix, end_of_file_handling_input) {
     EXPECT_EQ(5, matrix[1][1]);
     EXPECT_EQ(0, matrix[2][2]);
 }
+
+TEST(TestMatrix, fused_expression) {
+    Matrix<int> matrix_1 = { { 1, 2 }, { 3, 4 } };
+    Matrix<int> matrix_2 = { { 5, 6 }, { 7, 8 } };
+    Matrix<int> expected_result = { { 4, 4 }, { 4, 4 } };
+
+    Matrix<int> actual_result = matrix_1 + matrix_2 - matrix_1 * 4 / 2;
+
+    EXPECT_EQ(expected_result, actual_result);
+}
+
+TEST(TestMatrix, fused_expression_reads_destination) {
+    Matrix<int> matrix_1 = { { 1, 2 }, { 3, 4 } };
+    Matrix<int> matrix_2 = { { 5, 6 }, { 7, 8 } };
+    Matrix<int> expected_result = { { 7, 10 }, { 13, 16 } };
+
+    matrix_1 = matrix_2 + matrix_1 * 2;
+
+    EXPECT_EQ(expected_result, matrix_1);
+}
+
+TEST(TestMatrix, fused_expression_with_different_size) {
+    Matrix<int> matrix_1(2, 3);
+    Matrix<int> matrix_2(3, 2);
+
+    ASSERT_ANY_THROW(Matrix<int> matrix_3 = matrix_1 * 2 + matrix_2);
+}
+
+TEST(TestMatrix, product_of_expressions) {
+    Matrix<int> matrix_1 = { { 1, 2 }, { 3, 4 } };
+    Matrix<int> identity = { { 1, 0 }, { 0, 1 } };
+    Matrix<int> expected_result = { { 2, 2 }, { 3, 5 } };
+    MVector<int> column = { 1, 1 };
+    MVector<int> expected_column = { 4, 8 };
+
+    EXPECT_EQ(expected_result, (matrix_1 + identity) * identity);
+    EXPECT_EQ(expected_result, identity * (matrix_1 + identity));
+    EXPECT_EQ(expected_column, (matrix_1 + identity) * column);
+}
+
+TEST(TestMatrix, rows_share_one_buffer) {
+    Matrix<int> matrix = {
+        {1, 2, 3},
+        {4, 5, 6}
+    };
+
+    EXPECT_EQ(3, matrix.stride());
+    EXPECT_EQ(matrix.data() + 3, matrix[1].data());
+    EXPECT_EQ(6, matrix.data()[5]);
+}
+
+TEST(TestMatrix, long_rows_start_on_cache_lines) {
+    Matrix<double> matrix(3, 10);
+
+    EXPECT_EQ(16, matrix.stride());
+
+    for (size_t i = 0; i < matrix.rows(); i++) {
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(matrix[i].data()) % 64);
+    }
+}
+
+TEST(TestMatrix, access_out_of_range) {
+    Matrix<int> matrix(2, 3);
+    const Matrix<int>& view = matrix;
+
+    ASSERT_ANY_THROW(matrix[2]);
+    ASSERT_ANY_THROW(matrix[1][3]);
+    ASSERT_ANY_THROW(view[2][0]);
+}
+
+TEST(TestMatrix, row_assignment_writes_elements) {
+    Matrix<int> matrix = {
+        {1, 2},
+        {3, 4}
+    };
+    Matrix<int> expected = {
+        {3, 4},
+        {9, 9}
+    };
+
+    matrix[0] = matrix[1];
+    matrix[1] = MVector<int>({ 9, 9 });
+
+    EXPECT_EQ(expected, matrix);
+    ASSERT_ANY_THROW(matrix[0] = MVector<int>({ 1, 2, 3 }));
+}
+
+TEST(TestMatrix, row_expressions) {
+    Matrix<double> matrix = {
+        {1.0, 2.0, 3.0},
+        {4.0, 5.0, 6.0}
+    };
+    MVector<double> expected_sum = { 5.0, 7.0, 9.0 };
+    MVector<double> expected_row = { -1.0, 1.0, 3.0 };
+
+    MVector<double> sum = matrix[0] + matrix[1];
+    matrix[0] *= 3.0;
+    matrix[0] -= matrix[1];
+
+    EXPECT_EQ(expected_sum, sum);
+    EXPECT_EQ(expected_row, MVector<double>(matrix[0]));
+    EXPECT_NEAR(38.0, matrix[0] * (matrix[1] * 2.0), EPSILON);
+}
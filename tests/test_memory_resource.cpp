@@ -0,0 +1,457 @@
+// Copyright 2026 Chernykh Valentin
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include "libs/lib_memory_resource/memory_resource.h"
+#include "libs/lib_tvector/tvector.h"
+#include "libs/lib_concurrent_tvector/concurrent_tvector.h"
+#include "libs/lib_mvector/mvector.h"
+#include "libs/lib_matrix/matrix.h"
+#include "libs/lib_triangle_matrix/triangle_matrix.h"
+#include "libs/lib_unordered_array_table/unordered_array_table.h"
+
+#define EPSILON 0.000001
+
+// Forwards to new/delete and counts what passes through
+class CountingResource : public MemoryResource {
+ public:
+    int allocations = 0;
+    int deallocations = 0;
+    size_t bytes_in_use = 0;
+
+    void* allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        bytes_in_use += bytes;
+        return new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment)
+        noexcept override {
+        deallocations++;
+        bytes_in_use -= bytes;
+        new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+};
+
+bool is_aligned(void* ptr, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(TestMemoryResource, DefaultIsNewDelete) {
+    EXPECT_EQ(new_delete_resource(), get_default_resource());
+}
+
+TEST(TestMemoryResource, ScopedDefaultResource) {
+    CountingResource counting;
+
+    {
+        ScopedDefaultResource scope(&counting);
+        EXPECT_EQ(&counting, get_default_resource());
+    }
+
+    EXPECT_EQ(new_delete_resource(), get_default_resource());
+}
+
+TEST(TestMemoryResource, ArenaAlignment) {
+    MonotonicArena arena(64);
+
+    void* first = arena.allocate(1, 1);
+    void* second = arena.allocate(8, 8);
+    void* third = arena.allocate(3, 16);
+
+    EXPECT_TRUE(is_aligned(second, 8));
+    EXPECT_TRUE(is_aligned(third, 16));
+    EXPECT_NE(first, second);
+    EXPECT_NE(second, third);
+}
+
+TEST(TestMemoryResource, NewDeleteOverAligned) {
+    void* first = new_delete_resource()->allocate(24, 64);
+    void* second = new_delete_resource()->allocate(8, 128);
+
+    EXPECT_TRUE(is_aligned(first, 64));
+    EXPECT_TRUE(is_aligned(second, 128));
+
+    new_delete_resource()->deallocate(first, 24, 64);
+    new_delete_resource()->deallocate(second, 8, 128);
+}
+
+TEST(TestMemoryResource, ArenaGrowsAndReleases) {
+    CountingResource counting;
+
+    {
+        MonotonicArena arena(64, &counting);
+
+        for (int i = 0; i < 100; i++) {
+            arena.allocate(32, 8);
+        }
+
+        EXPECT_GE(arena.reserved(), 3200);
+        EXPECT_LT(counting.allocations, 10);
+
+        arena.release();
+        EXPECT_EQ(0, arena.reserved());
+        EXPECT_EQ(0, counting.bytes_in_use);
+
+        arena.allocate(16, 8);
+    }
+
+    EXPECT_EQ(counting.allocations, counting.deallocations);
+}
+
+TEST(TestMemoryResource, PoolReusesBlocks) {
+    PoolResource pool;
+
+    void* first = pool.allocate(24, 8);
+    pool.deallocate(first, 24, 8);
+    void* second = pool.allocate(20, 4);
+
+    EXPECT_EQ(first, second);
+    EXPECT_TRUE(is_aligned(second, 8));
+}
+
+TEST(TestMemoryResource, PoolSizeClassesDoNotMix) {
+    PoolResource pool;
+
+    void* small = pool.allocate(8, 8);
+    void* large = pool.allocate(100, 8);
+
+    pool.deallocate(small, 8, 8);
+    EXPECT_NE(small, pool.allocate(100, 8));
+    EXPECT_EQ(small, pool.allocate(8, 8));
+
+    pool.deallocate(large, 100, 8);
+}
+
+TEST(TestMemoryResource, PoolLargeRequestsGoUpstream) {
+    CountingResource counting;
+    PoolResource pool(&counting);
+
+    void* big = pool.allocate(100000, 8);
+    EXPECT_EQ(1, counting.allocations);
+
+    pool.deallocate(big, 100000, 8);
+    EXPECT_EQ(1, counting.deallocations);
+
+    pool.allocate(64, 8);
+    pool.release();
+    EXPECT_EQ(0, counting.bytes_in_use);
+}
+
+TEST(TestMemoryResource, TVectorAllocatesFromResource) {
+    CountingResource counting;
+
+    {
+        TVector<int> vec(&counting);
+
+        for (int i = 0; i < 100; i++) {
+            vec.push_back(i);
+        }
+
+        for (int i = 0; i < 30; i++) {
+            vec.erase(vec.begin() + i);
+        }
+
+        EXPECT_EQ(70, vec.size());
+        EXPECT_EQ(&counting, vec.resource());
+        EXPECT_GT(counting.allocations, 0);
+    }
+
+    EXPECT_EQ(counting.allocations, counting.deallocations);
+    EXPECT_EQ(0, counting.bytes_in_use);
+}
+
+TEST(TestMemoryResource, TVectorPushFrontGrowsGeometrically) {
+    CountingResource counting;
+    TVector<int> vec(&counting);
+
+    for (int i = 0; i < 100000; i++) {
+        vec.push_front(i);
+    }
+
+    EXPECT_EQ(100000, vec.size());
+    EXPECT_LT(counting.allocations, 60);
+}
+
+TEST(TestMemoryResource, TVectorBulkEraseDoesNotAllocate) {
+    CountingResource counting;
+    TVector<int> vec(&counting);
+
+    for (int i = 0; i < 10000; i++) {
+        vec.push_back(i);
+    }
+
+    int allocations = counting.allocations;
+
+    vec.erase_if([](int elem) { return elem % 4 == 0; });
+    vec.erase(vec.begin() + 100, vec.begin() + 2000);
+    vec.retain([](int elem) { return elem % 3 != 0; });
+
+    EXPECT_EQ(allocations, counting.allocations);
+    EXPECT_EQ(3733, vec.size());
+}
+
+TEST(TestMemoryResource, TVectorDeferredCompactionDoesNotAllocate) {
+    CountingResource counting;
+    TVector<int> manual(&counting);
+    TVector<int> incremental(&counting);
+
+    manual.set_compaction_policy(Manual);
+    incremental.set_compaction_policy(Incremental);
+
+    for (int i = 0; i < 1000; i++) {
+        manual.push_back(i);
+        incremental.push_back(i);
+    }
+
+    manual.erase(manual.begin());
+    incremental.erase(incremental.begin());
+
+    // Only the rank trees were built so far.
+    int allocations = counting.allocations;
+
+    for (int i = 1; i < 500; i++) {
+        manual.erase(manual.begin() + i);
+        incremental.erase(incremental.begin() + i);
+    }
+
+    manual.compact();
+
+    EXPECT_EQ(allocations, counting.allocations);
+    EXPECT_EQ(manual, incremental);
+    EXPECT_EQ(999, manual[499]);
+}
+
+TEST(TestMemoryResource, TVectorAppendReallocatesOnce) {
+    CountingResource counting;
+    TVector<int> vec({ 1, 2, 3 }, &counting);
+    TVector<int> shard;
+
+    for (int i = 0; i < 10000; i++) {
+        shard.push_back(i);
+    }
+
+    int allocations = counting.allocations;
+
+    vec.append(shard);
+    EXPECT_EQ(allocations + 2, counting.allocations);
+
+    allocations = counting.allocations;
+    vec.insert(vec.begin() + 2, shard.begin(), shard.end());
+    EXPECT_EQ(allocations + 2, counting.allocations);
+    EXPECT_EQ(20003, vec.size());
+    EXPECT_EQ(9999, vec[10001]);
+}
+
+TEST(TestMemoryResource, TVectorCopyUsesDefaultResource) {
+    CountingResource counting;
+    TVector<int> vec({ 1, 2, 3 }, &counting);
+    TVector<int> copy(vec);
+    TVector<int> copy_in_resource(vec, &counting);
+
+    EXPECT_EQ(new_delete_resource(), copy.resource());
+    EXPECT_EQ(&counting, copy_in_resource.resource());
+    EXPECT_EQ(vec, copy);
+    EXPECT_EQ(vec, copy_in_resource);
+}
+
+TEST(TestMemoryResource, TVectorMoveBetweenResources) {
+    CountingResource counting;
+    MonotonicArena arena;
+    TVector<std::string> source(&arena);
+    TVector<std::string> target(&counting);
+
+    for (int i = 0; i < 20; i++) {
+        source.push_back(std::to_string(i));
+    }
+
+    target = std::move(source);
+
+    EXPECT_EQ(&counting, target.resource());
+    EXPECT_EQ(20, target.size());
+    EXPECT_EQ("19", target[19]);
+    EXPECT_EQ(0, source.size());
+}
+
+TEST(TestMemoryResource, TVectorMoveKeepsResource) {
+    MonotonicArena arena;
+    TVector<int> vec({ 1, 2, 3 }, &arena);
+    TVector<int> moved(std::move(vec));
+
+    EXPECT_EQ(&arena, moved.resource());
+    EXPECT_EQ(3, moved.size());
+}
+
+TEST(TestMemoryResource, ConcurrentTVectorReserve) {
+    CountingResource counting;
+
+    {
+        ConcurrentTVector<std::string> vec(&counting);
+
+        vec.reserve(1000);
+        int allocations = counting.allocations;
+
+        for (int i = 0; i < 1000; i++) {
+            vec.push_back(std::to_string(i));
+        }
+
+        EXPECT_EQ(allocations, counting.allocations);
+        EXPECT_EQ("999", vec[999]);
+    }
+
+    EXPECT_EQ(0, counting.bytes_in_use);
+}
+
+TEST(TestMemoryResource, MatrixRowsFromResource) {
+    CountingResource counting;
+
+    {
+        Matrix<double> matrix(4, 5, &counting);
+
+        EXPECT_EQ(&counting, matrix.resource());
+        EXPECT_EQ(1, counting.allocations);
+        EXPECT_EQ(matrix.data(), matrix[0].data());
+        EXPECT_EQ(matrix.data() + 3 * matrix.stride(), matrix[3].data());
+        matrix[3][4] = 1.5;
+        EXPECT_NEAR(1.5, matrix[3][4], EPSILON);
+    }
+
+    EXPECT_EQ(0, counting.bytes_in_use);
+}
+
+TEST(TestMemoryResource, MatrixComputationInArena) {
+    Matrix<int> a = { { 1, 2 }, { 3, 4 } };
+    Matrix<int> b = { { 5, 6 }, { 7, 8 } };
+    Matrix<int> expected = { { 19, 22 }, { 43, 50 } };
+    Matrix<int> result;
+    CountingResource counting;
+    MonotonicArena arena(4096, &counting);
+
+    {
+        ScopedDefaultResource scope(&arena);
+        Matrix<int> product = a * b;
+
+        EXPECT_EQ(&arena, product.resource());
+        result = product;
+    }
+
+    int upstream_calls = counting.allocations;
+    arena.release();
+
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(new_delete_resource(), result.resource());
+    EXPECT_LT(upstream_calls, 5);
+}
+
+TEST(TestMemoryResource, TriangleMatrixFromResource) {
+    PoolResource pool;
+    TriangleMatrix<int> matrix(3, &pool);
+
+    matrix.set(0, 2, 7);
+
+    EXPECT_EQ(&pool, matrix.resource());
+    EXPECT_EQ(7, matrix.at(0, 2));
+}
+
+TEST(TestMemoryResource, MVectorFromResource) {
+    PoolResource pool;
+    MVector<int> vec(3, &pool);
+
+    vec[1] = 4;
+
+    EXPECT_EQ(&pool, vec.resource());
+    EXPECT_EQ(16, vec * vec);
+}
+
+TEST(TestMemoryResource, MVectorExpressionDoesNotAllocate) {
+    CountingResource counting;
+    MVector<double> a(1000, &counting);
+    MVector<double> b(1000, &counting);
+    MVector<double> result(1000, &counting);
+    Matrix<double> m(8, 8, &counting);
+    Matrix<double> n(8, 8, &counting);
+
+    {
+        ScopedDefaultResource scope(&counting);
+        int allocations = counting.allocations;
+
+        result = a + b - a * 2.0 + b / 4.0;
+        result += a;
+        m = m + n * 2.0 - n;
+        m -= n;
+
+        EXPECT_EQ(allocations, counting.allocations);
+    }
+}
+
+TEST(TestMemoryResource, CompoundAssignmentAndMovesDoNotAllocate) {
+    CountingResource counting;
+    MVector<double> a(1000, &counting);
+    Matrix<double> m(8, 8, &counting);
+    Matrix<double> n(8, 8, &counting);
+    TriangleMatrix<double> t(8, &counting);
+    TriangleMatrix<double> u(8, &counting);
+
+    {
+        ScopedDefaultResource scope(&counting);
+        int allocations = counting.allocations;
+
+        a *= 2.0;
+        a /= 4.0;
+        m += n;
+        m *= 3.0;
+        t += u;
+        t -= u;
+        t *= 2.0;
+        t /= 2.0;
+
+        MVector<double> moved_vector(std::move(a));
+        Matrix<double> moved_matrix(std::move(m));
+        TriangleMatrix<double> moved_triangle(std::move(t));
+
+        a = std::move(moved_vector);
+        m = std::move(moved_matrix);
+        t = std::move(moved_triangle);
+
+        EXPECT_EQ(allocations, counting.allocations);
+    }
+}
+
+TEST(TestMemoryResource, MatrixReshapingExpressionStaysInResource) {
+    CountingResource counting;
+    CountingResource other;
+    Matrix<double> a(4, 4, &other);
+    Matrix<double> b(4, 4, &other);
+    Matrix<double> result(2, 2, &counting);
+    int allocations = counting.allocations;
+
+    {
+        ScopedDefaultResource scope(&other);
+        int other_allocations = other.allocations;
+
+        result = a + b * 2.0;
+
+        EXPECT_EQ(other_allocations, other.allocations);
+    }
+
+    EXPECT_EQ(allocations + 1, counting.allocations);
+    EXPECT_EQ(&counting, result.resource());
+    EXPECT_EQ(4, result.rows());
+}
+
+TEST(TestMemoryResource, TableFromArena) {
+    MonotonicArena arena;
+    UnorderedArrayTable<int, std::string> table(&arena);
+
+    for (int i = 0; i < 50; i++) {
+        table.insert(i, std::to_string(i));
+    }
+
+    table.erase(10);
+
+    EXPECT_EQ(49, table.size());
+    EXPECT_EQ("20", *table.find(20));
+    EXPECT_EQ(nullptr, table.find(10));
+}
@@ -1,7 +1,10 @@
 // Copyright 2025 Chernykh Valentin
 
 #include <gtest/gtest.h>
+#include <cstdint>
+#include <utility>
 #include "libs/lib_mvector/mvector.h"
+#include "libs/lib_mvector/mvector_kernels.h"
 
 #define EPSILON 0.000001
 
@@ -51,6 +54,28 @@ TEST(TestMVector, assign_to_mvector) {
     EXPECT_EQ(expected_result, actual_result);
 }
 
+TEST(TestMVector, move_init) {
+    MVector<int> vec_1 = { 1, 2, 3 };
+    const int* storage = vec_1.data();
+    MVector<int> vec_2(std::move(vec_1));
+
+    EXPECT_EQ(storage, vec_2.data());
+    EXPECT_EQ(MVector<int>({ 1, 2, 3 }), vec_2);
+    EXPECT_EQ(0, vec_1.size());
+}
+
+TEST(TestMVector, move_assign) {
+    MVector<int> vec_1 = { 1, 2, 3 };
+    MVector<int> vec_2(5);
+    const int* storage = vec_1.data();
+
+    vec_2 = std::move(vec_1);
+
+    EXPECT_EQ(storage, vec_2.data());
+    EXPECT_EQ(3, vec_2.size());
+    EXPECT_EQ(0, vec_1.size());
+}
+
 TEST(TestMVector, add_to_mvector) {
     MVector<int> vec_1 = {1, 2, 3};
     MVector<int> vec_2 = {4, 5, 6};
@@ -226,3 +251,126 @@ TEST(TestMVector, inequality_operator_different_size) {
 
     EXPECT_TRUE(vector_1 != vector_2);
 }
+
+TEST(TestMVector, fused_expression) {
+    MVector<int> vec_1 = {1, 2, 3};
+    MVector<int> vec_2 = {4, 5, 6};
+    MVector<int> vec_3 = {1, 1, 2};
+    MVector<int> expected_result = {3, 5, 5};
+
+    MVector<int> actual_result = vec_1 + vec_2 - vec_3 * 2;
+
+    EXPECT_EQ(expected_result, actual_result);
+}
+
+TEST(TestMVector, fused_expression_reads_destination) {
+    MVector<int> vec_1 = {1, 2, 3};
+    MVector<int> vec_2 = {4, 5, 6};
+    MVector<int> expected_result = {6, 9, 12};
+
+    vec_1 = vec_2 + vec_1 * 2;
+
+    EXPECT_EQ(expected_result, vec_1);
+}
+
+TEST(TestMVector, fused_expression_resizes_destination) {
+    MVector<int> vec_1 = {1, 2, 3};
+    MVector<int> vec_2 = {4, 5, 6};
+    MVector<int> actual_result = {1};
+    MVector<int> expected_result = {5, 7, 9};
+
+    actual_result = vec_1 + vec_2;
+
+    EXPECT_EQ(expected_result, actual_result);
+}
+
+TEST(TestMVector, fused_expression_with_different_size) {
+    MVector<int> vec_1 = {1, 2, 3};
+    MVector<int> vec_2 = {4, 5};
+
+    ASSERT_ANY_THROW(MVector<int> vec_3 = vec_1 * 2 + vec_2;);
+    ASSERT_ANY_THROW(MVector<int> vec_3 = (vec_1 - vec_1) / 0;);
+}
+
+TEST(TestMVector, dot_product_of_expressions) {
+    MVector<int> vec_1 = {1, 2, 3};
+    MVector<int> vec_2 = {4, 5, 6};
+
+    EXPECT_EQ(5 * 4 + 7 * 5 + 9 * 6, (vec_1 + vec_2) * vec_2);
+    EXPECT_EQ(4 * 4 + 5 * 5 + 6 * 6, vec_2 * (vec_1 + vec_2 - vec_1));
+}
+
+namespace {
+
+// Runs check on every instruction set this machine supports, then goes
+// back to the widest.
+template<class Check>
+void for_each_isa(Check check) {
+    mvector_kernels::Isa widest = mvector_kernels::detected_isa();
+
+    for (int isa = mvector_kernels::IsaScalar; isa <= widest; isa++) {
+        mvector_kernels::use_isa(static_cast<mvector_kernels::Isa>(isa));
+        EXPECT_EQ(isa, mvector_kernels::active_isa());
+        check();
+    }
+
+    mvector_kernels::use_isa(widest);
+}
+
+template<typename T>
+void check_kernels(double tolerance) {
+    const size_t sizes[] = { 0, 1, 3, 8, 17, 33, 100 };
+
+    for (size_t size : sizes) {
+        MVector<T> a(static_cast<int>(size));
+        MVector<T> b(static_cast<int>(size));
+        T dot{};
+
+        for (size_t i = 0; i < size; i++) {
+            a[i] = static_cast<T>(i % 7) - 3;
+            b[i] = static_cast<T>(i % 5) + 1;
+            dot += a[i] * b[i];
+        }
+
+        MVector<T> sum = a + b;
+        MVector<T> difference = a - b;
+        MVector<T> scaled = a * T(3);
+
+        EXPECT_NEAR(static_cast<double>(dot), static_cast<double>(a * b),
+            tolerance);
+
+        for (size_t i = 0; i < size; i++) {
+            EXPECT_EQ(a[i] + b[i], sum[i]);
+            EXPECT_EQ(a[i] - b[i], difference[i]);
+            EXPECT_EQ(a[i] * T(3), scaled[i]);
+        }
+
+        a += b;
+        EXPECT_EQ(sum, a);
+    }
+}
+
+}  // namespace
+
+TEST(TestMVector, kernels_match_plain_loops) {
+    for_each_isa([]() {
+        check_kernels<float>(EPSILON);
+        check_kernels<double>(EPSILON);
+        check_kernels<int32_t>(0);
+        check_kernels<int64_t>(0);
+    });
+}
+
+TEST(TestMVector, kernels_wrap_64_bit_products) {
+    MVector<int64_t> a = { int64_t(1) << 40, -(int64_t(3) << 33), 7, -1, 5 };
+    MVector<int64_t> b = { 1 << 20, 1 << 2, -(int64_t(1) << 35), 9, 2 };
+
+    for_each_isa([&a, &b]() {
+        MVector<int64_t> scaled = a * int64_t(-(int64_t(1) << 21));
+
+        EXPECT_EQ(-(int64_t(1) << 61), scaled[0]);
+        EXPECT_EQ(int64_t(3) << 54, scaled[1]);
+        EXPECT_EQ((int64_t(1) << 60) - (int64_t(3) << 35) -
+            (int64_t(7) << 35) - 9 + 10, a * b);
+    });
+}
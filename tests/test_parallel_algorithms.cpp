@@ -0,0 +1,185 @@
+// Copyright 2026 Chernykh Valentin
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include "libs/lib_parallel_algorithms/parallel_algorithms.h"
+
+namespace {
+
+// 0 .. count - 1 with every third element erased, the Deleted slots kept.
+TVector<int> holey(int count) {
+    TVector<int> vec;
+    vec.set_compaction_policy(Manual);
+
+    for (int i = 0; i < count; i++) {
+        vec.push_back(i);
+    }
+
+    for (auto it = vec.begin(); it != vec.end();) {
+        if (*it % 3 == 0)
+            it = vec.erase(it);
+        else
+            ++it;
+    }
+
+    return vec;
+}
+
+int add(int a, int b) {
+    return a + b;
+}
+
+}  // namespace
+
+TEST(TestThreadPool, RunsEveryTaskOnce) {
+    ThreadPool pool(4);
+    std::atomic<int> calls[100];
+
+    for (auto& call : calls) {
+        call = 0;
+    }
+
+    pool.run(100, [&calls](size_t i) { calls[i]++; });
+
+    EXPECT_EQ(4, pool.concurrency());
+
+    for (auto& call : calls) {
+        EXPECT_EQ(1, call.load());
+    }
+}
+
+TEST(TestThreadPool, RethrowsAndStaysUsable) {
+    ThreadPool pool(3);
+    std::atomic<int> calls(0);
+
+    EXPECT_THROW(pool.run(10, [](size_t i) {
+        if (i == 5)
+            throw std::runtime_error("task");
+    }), std::runtime_error);
+
+    pool.run(10, [&calls, &pool](size_t) {
+        pool.run(2, [&calls](size_t) { calls++; });
+    });
+
+    EXPECT_EQ(20, calls.load());
+}
+
+TEST(TestParallelAlgorithms, SkipDeletedSlots) {
+    TVector<int> vec = holey(10000);
+    ParallelPolicy policies[] = {
+        ParallelPolicy(StaticSchedule, 1),
+        ParallelPolicy(DynamicSchedule, 7),
+        ParallelPolicy()
+    };
+    int64_t expected = 0;
+
+    for (int x : vec) {
+        expected += x;
+    }
+
+    ASSERT_FALSE(vec.is_dense());
+
+    for (const ParallelPolicy& policy : policies) {
+        std::atomic<int64_t> seen(0);
+
+        parallel_for_each(vec, [&seen](int& x) { seen += x; }, policy);
+
+        EXPECT_EQ(expected, seen.load());
+        EXPECT_EQ(expected, parallel_reduce(vec, int64_t(0),
+            [](int64_t a, int64_t b) { return a + b; }, policy));
+        EXPECT_EQ(vec.size(), parallel_count_if(vec,
+            [](int x) { return x % 3 != 0; }, policy));
+    }
+}
+
+TEST(TestParallelAlgorithms, TransformKeepsOrder) {
+    TVector<int> vec = holey(5000);
+    TVector<int> out;
+    MVector<double> halves;
+
+    parallel_transform(vec, out, [](int x) { return x * 2; },
+        ParallelPolicy(DynamicSchedule, 64));
+    parallel_transform(vec, halves, [](int x) { return x / 2.0; },
+        ParallelPolicy(StaticSchedule, 1));
+
+    ASSERT_EQ(vec.size(), out.size());
+    ASSERT_EQ(vec.size(), halves.size());
+
+    size_t i = 0;
+
+    for (int x : vec) {
+        EXPECT_EQ(x * 2, out[i]);
+        EXPECT_EQ(x / 2.0, halves[i]);
+        i++;
+    }
+}
+
+TEST(TestParallelAlgorithms, ScansMatchSerial) {
+    TVector<int> vec = holey(3001);
+    TVector<int> inclusive;
+    TVector<int> exclusive;
+
+    parallel_inclusive_scan(vec, inclusive, add,
+        ParallelPolicy(StaticSchedule, 1));
+    parallel_exclusive_scan(vec, exclusive, 10, add,
+        ParallelPolicy(DynamicSchedule, 5));
+
+    ASSERT_EQ(vec.size(), inclusive.size());
+    ASSERT_EQ(vec.size(), exclusive.size());
+
+    int sum = 0;
+    size_t i = 0;
+
+    for (int x : vec) {
+        EXPECT_EQ(sum + 10, exclusive[i]);
+        sum += x;
+        EXPECT_EQ(sum, inclusive[i]);
+        i++;
+    }
+}
+
+TEST(TestParallelAlgorithms, CopyIfKeepsOrder) {
+    TVector<int> vec = holey(4000);
+    TVector<int> even;
+
+    parallel_copy_if(vec, even, [](int x) { return x % 2 == 0; },
+        ParallelPolicy(DynamicSchedule, 3));
+
+    size_t i = 0;
+
+    for (int x : vec) {
+        if (x % 2 == 0) {
+            ASSERT_LT(i, even.size());
+            EXPECT_EQ(x, even[i++]);
+        }
+    }
+
+    EXPECT_EQ(i, even.size());
+}
+
+TEST(TestParallelAlgorithms, WorksOnMVector) {
+    MVector<int> vec(1000);
+    MVector<int> scan;
+
+    parallel_for_each(vec, [](int& x) { x = 1; },
+        ParallelPolicy(StaticSchedule, 1));
+    parallel_inclusive_scan(vec, scan, add, ParallelPolicy(StaticSchedule, 1));
+
+    EXPECT_EQ(1000, parallel_reduce(vec, 0, add));
+    ASSERT_EQ(1000, scan.size());
+    EXPECT_EQ(1000, scan[999]);
+    EXPECT_EQ(500, scan[499]);
+}
+
+TEST(TestParallelAlgorithms, EmptyInput) {
+    TVector<int> vec;
+    TVector<int> out(5);
+
+    parallel_copy_if(vec, out, [](int) { return true; });
+    parallel_inclusive_scan(vec, out, add);
+
+    EXPECT_EQ(7, parallel_reduce(vec, 7, add));
+    EXPECT_EQ(0, parallel_count_if(vec, [](int) { return true; }));
+    EXPECT_TRUE(out.is_empty());
+}
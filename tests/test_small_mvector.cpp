@@ -0,0 +1,156 @@
+// Copyright 2026 Chernykh Valentin
+
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include "libs/lib_memory_resource/memory_resource.h"
+#include "libs/lib_mvector/mvector.h"
+#include "libs/lib_small_mvector/small_mvector.h"
+
+#define EPSILON 0.000001
+
+TEST(TestSmallMVector, init) {
+    SmallMVector<int, 4> vec;
+
+    EXPECT_EQ(0, vec.size());
+    EXPECT_TRUE(vec.is_inline());
+}
+
+TEST(TestSmallMVector, negative_size_init) {
+    ASSERT_ANY_THROW((SmallMVector<int, 4>(-5)));
+}
+
+TEST(TestSmallMVector, size_init_zeroed) {
+    SmallMVector<int, 4> vec(3);
+
+    EXPECT_EQ(3, vec.size());
+    EXPECT_EQ(0, vec[0]);
+    EXPECT_EQ(0, vec[2]);
+}
+
+TEST(TestSmallMVector, stays_inline_up_to_capacity) {
+    MonotonicArena arena;
+    ScopedDefaultResource scope(&arena);
+    SmallMVector<double, 3> vec = { 1.0, 2.0, 3.0 };
+
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(3, vec.inline_capacity());
+    EXPECT_EQ(0, arena.reserved());
+}
+
+TEST(TestSmallMVector, spills_beyond_capacity) {
+    SmallMVector<int, 2> vec = { 1, 2, 3, 4, 5 };
+
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_EQ(5, vec.size());
+    EXPECT_EQ(5, vec[4]);
+}
+
+TEST(TestSmallMVector, index_out_of_range) {
+    SmallMVector<int, 2> vec = { 1, 2 };
+
+    EXPECT_THROW(vec[2], std::out_of_range);
+}
+
+TEST(TestSmallMVector, copy_and_assign) {
+    SmallMVector<int, 2> small = { 1, 2 };
+    SmallMVector<int, 2> big = { 1, 2, 3 };
+    SmallMVector<int, 2> copy(big);
+
+    EXPECT_EQ(big, copy);
+    EXPECT_FALSE(copy.is_inline());
+
+    copy = small;
+    EXPECT_EQ(small, copy);
+    EXPECT_TRUE(copy.is_inline());
+}
+
+TEST(TestSmallMVector, move_steals_heap_buffer) {
+    SmallMVector<std::string, 1> source = { "a", "b", "c" };
+    SmallMVector<std::string, 1> target(std::move(source));
+
+    EXPECT_EQ(3, target.size());
+    EXPECT_EQ("c", target[2]);
+    EXPECT_EQ(0, source.size());
+}
+
+TEST(TestSmallMVector, move_inline_elements) {
+    SmallMVector<std::string, 2> source = { "a", "b" };
+    SmallMVector<std::string, 2> target;
+
+    target = std::move(source);
+
+    EXPECT_TRUE(target.is_inline());
+    EXPECT_EQ("b", target[1]);
+}
+
+TEST(TestSmallMVector, arithmetic) {
+    SmallMVector<int, 3> vec_1 = { 1, 2, 3 };
+    SmallMVector<int, 3> vec_2 = { 4, 5, 6 };
+    SmallMVector<int, 3> sum = { 5, 7, 9 };
+    SmallMVector<int, 3> diff = { -3, -3, -3 };
+    SmallMVector<int, 3> scaled = { 2, 4, 6 };
+
+    EXPECT_EQ(sum, vec_1 + vec_2);
+    EXPECT_EQ(diff, vec_1 - vec_2);
+    EXPECT_EQ(32, vec_1 * vec_2);
+    EXPECT_EQ(scaled, vec_1 * 2);
+    EXPECT_EQ(vec_1, scaled / 2);
+}
+
+TEST(TestSmallMVector, compound_assignment) {
+    SmallMVector<int, 2> vec = { 1, 2 };
+    SmallMVector<int, 2> other = { 3, 4 };
+    SmallMVector<int, 2> expected = { 4, 6 };
+
+    vec += other;
+    EXPECT_EQ(expected, vec);
+
+    vec -= other;
+    vec *= 3;
+    vec /= 3;
+    EXPECT_NE(expected, vec);
+    EXPECT_EQ(2, vec[1]);
+}
+
+TEST(TestSmallMVector, size_mismatch) {
+    SmallMVector<int, 4> vec_1 = { 1, 2 };
+    SmallMVector<int, 4> vec_2 = { 1, 2, 3 };
+
+    EXPECT_THROW(vec_1 + vec_2, std::invalid_argument);
+    EXPECT_THROW(vec_1 * vec_2, std::invalid_argument);
+    EXPECT_THROW(vec_1 / 0, std::invalid_argument);
+}
+
+TEST(TestSmallMVector, length_and_normalized) {
+    SmallMVector<double, 2> vec = { 3.0, 4.0 };
+    SmallMVector<double, 2> unit = vec.normalized();
+
+    EXPECT_NEAR(5.0, vec.length(), EPSILON);
+    EXPECT_NEAR(0.6, unit[0], EPSILON);
+    EXPECT_NEAR(0.8, unit[1], EPSILON);
+}
+
+TEST(TestSmallMVector, nested) {
+    SmallMVector<SmallMVector<int, 2>, 4> directions = {
+        { -1, 0 },
+        { 0, -1 },
+        { 1, 0 },
+        { 0, 1 }
+    };
+
+    EXPECT_EQ(4, directions.size());
+    EXPECT_EQ(-1, directions[1][1]);
+    EXPECT_TRUE(directions[3].is_inline());
+}
+
+TEST(TestSmallMVector, converts_to_and_from_mvector) {
+    SmallMVector<int, 2> small = { 1, 2, 3 };
+    MVector<int> dynamic = small;
+    MVector<int> expected = { 1, 2, 3 };
+
+    EXPECT_EQ(expected, dynamic);
+    EXPECT_EQ(small, (SmallMVector<int, 2>(dynamic)));
+    EXPECT_TRUE((SmallMVector<int, 4>(dynamic)).is_inline());
+    EXPECT_FALSE((SmallMVector<int, 2>(dynamic)).is_inline());
+}
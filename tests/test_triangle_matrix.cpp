@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <utility>
 #include "libs/lib_triangle_matrix/triangle_matrix.h"
 
 #define EPSILON 0.000001
@@ -45,6 +46,20 @@ TEST(TestTriangleMatrix, copy_init) {
     EXPECT_EQ(3, matrix_2.dim());
 }
 
+TEST(TestTriangleMatrix, move_init) {
+    TriangleMatrix<int> matrix_1 = {
+        {1, 2, 3},
+        {4, 5},
+        {6}
+    };
+
+    TriangleMatrix<int> matrix_2(std::move(matrix_1));
+
+    EXPECT_EQ(3, matrix_2.dim());
+    EXPECT_EQ(5, matrix_2.at(1, 2));
+    EXPECT_EQ(0, matrix_1.dim());
+}
+
 TEST(TestTriangleMatrix, equality_operator_equal) {
     TriangleMatrix<int> matrix_1 = {{1, 2, 3}, {4, 5}, {6}};
     TriangleMatrix<int> matrix_2 = {{1, 2, 3}, {4, 5}, {6}};
@@ -225,6 +240,20 @@ TEST(TestTriangleMatrix, assignment_self_assignment) {
     EXPECT_EQ(&matrix, &assigned_ref);
 }
 
+TEST(TestTriangleMatrix, move_assignment) {
+    TriangleMatrix<int> matrix_1 = {
+        {10, 20},
+        {30}
+    };
+    TriangleMatrix<int> matrix_2(3);
+
+    matrix_2 = std::move(matrix_1);
+
+    EXPECT_EQ(2, matrix_2.dim());
+    EXPECT_EQ(30, matrix_2.at(1, 1));
+    EXPECT_EQ(0, matrix_1.dim());
+}
+
 TEST(TestTriangleMatrix, assignment_chained) {
     TriangleMatrix<int> matrix_A(1);
     TriangleMatrix<int> matrix_B(1);
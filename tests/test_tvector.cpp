@@ -5,6 +5,11 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include "libs/lib_tvector/tvector.h"
 
@@ -39,6 +44,40 @@ bool search_predicate_all_match(int x) {
     return x >= 0;
 }
 
+// Element type without a default constructor that counts live objects and
+// copies, to check how TVector manages element lifetimes
+struct Tracked {
+    static int alive;
+    static int copies;
+    static int moves;
+    int value;
+
+    explicit Tracked(int v) : value(v) { alive++; }
+    Tracked(const Tracked& other) : value(other.value) {
+        alive++;
+        copies++;
+    }
+    Tracked(Tracked&& other) noexcept : value(other.value) {
+        alive++;
+        moves++;
+    }
+    Tracked& operator=(const Tracked& other) {
+        value = other.value;
+        copies++;
+        return *this;
+    }
+    Tracked& operator=(Tracked&& other) noexcept {
+        value = other.value;
+        moves++;
+        return *this;
+    }
+    ~Tracked() { alive--; }
+};
+
+int Tracked::alive = 0;
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
 // TVector Constructor Tests
 TEST(TVectorTest, DefaultInit) {
     TVector<int> vec;
@@ -722,6 +761,7 @@ TEST(TVectorTest, IteratorDereference) {
     EXPECT_EQ(2, *it);
 }
 
+#if TVECTOR_CHECKED_ITERATORS
 TEST(TVectorTest, IteratorDereferenceEmpty) {
     TVector<int> vec;
 
@@ -733,6 +773,75 @@ TEST(TVectorTest, IteratorDereferenceOutOfRange) {
 
     EXPECT_THROW(*vec.end(), std::exception);
 }
+#endif
+
+TEST(TVectorTest, IteratorAssignmentKeepsParents) {
+    TVector<int> first = { 1, 2, 3 };
+    TVector<int> second = { 4 };
+    TVector<int>::Iterator it = first.begin();
+
+    it = second.begin();
+
+    EXPECT_TRUE(std::is_trivially_copyable<TVector<int>::Iterator>::value);
+    EXPECT_TRUE(
+        std::is_trivially_copyable<TVector<int>::ConstIterator>::value);
+    EXPECT_EQ(3, first.size());
+    EXPECT_EQ(4, *it);
+    EXPECT_TRUE(++it == second.end());
+}
+
+TEST(TVectorTest, IteratorWalksAroundDeleted) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(i);
+    }
+
+    vec.set_compaction_policy(Manual);
+    vec.erase(vec.begin() + 10);
+    vec.erase(vec.begin() + 50);
+
+    int sum = 0;
+
+    for (int elem : vec) {
+        sum += elem;
+    }
+
+    auto last = vec.end();
+    --last;
+
+    EXPECT_EQ(4950 - 10 - 51, sum);
+    EXPECT_EQ(98, vec.end() - vec.begin());
+    EXPECT_EQ(99, *last);
+    EXPECT_EQ(52, *(vec.begin() + 50));
+}
+
+TEST(TVectorTest, IteratorMinusPastFrontWithFrontRoomAndDeleted) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 20; i++) {
+        vec.push_back(i);
+    }
+
+    vec.push_front(-1);
+    vec.push_front(-2);
+    vec.set_compaction_policy(Manual);
+    vec.erase(vec.begin() + 5);
+    vec.erase(vec.begin() + 5);
+
+    const TVector<int>& view = vec;
+    auto it = vec.begin() + 8;
+    auto cit = view.begin() + 8;
+
+    EXPECT_EQ(8, *it);
+    EXPECT_EQ(-2, *(it - 8));
+    EXPECT_TRUE(vec.begin() == it - 8);
+    EXPECT_THROW(it - 9, std::out_of_range);
+    EXPECT_THROW(it -= 9, std::out_of_range);
+    EXPECT_EQ(8, *it);
+    EXPECT_EQ(-2, *(cit - 8));
+    EXPECT_THROW(cit - 9, std::out_of_range);
+}
 
 TEST(TVectorTest, IteratorArrowOperator) {
     TVector<int> vect(1, 5);
@@ -1004,6 +1113,169 @@ TEST(TVectorTest, IteratorSkipDeleted) {
     EXPECT_EQ(expected, collected);
 }
 
+TEST(TVectorTest, IteratorSkipDeletedAcrossWords) {
+    TVector<int> vec;
+    vec.reserve(200);
+
+    for (int i = 0; i < 200; ++i) {
+        vec.push_back(i);
+    }
+
+    vec.erase(vec.begin() + 199);
+    vec.erase(vec.begin() + 128);
+    vec.erase(vec.begin() + 64);
+    vec.erase(vec.begin() + 63);
+    vec.erase(vec.begin());
+
+    int expected = 1;
+    size_t count = 0;
+
+    for (auto it = vec.begin(); it != vec.end(); ++it) {
+        while (expected == 63 || expected == 64 || expected == 128) {
+            expected++;
+        }
+
+        EXPECT_EQ(expected, *it);
+        expected++;
+        count++;
+    }
+
+    EXPECT_EQ(195u, count);
+    EXPECT_EQ(195, vec.end() - vec.begin());
+    EXPECT_EQ(1, vec.front());
+    EXPECT_EQ(198, vec.back());
+    EXPECT_EQ(198, *(vec.end() - 1));
+    EXPECT_EQ(130, *(vec.begin() + 126));
+}
+
+TEST(TVectorTest, SearchWithDeletionsAcrossWords) {
+    TVector<int> vec;
+    vec.reserve(200);
+
+    for (int i = 0; i < 200; ++i) {
+        vec.push_back(i);
+    }
+
+    vec.erase(vec.begin() + 100);
+    vec.erase(vec.begin());
+
+    EXPECT_EQ(1, search_begin(vec, find_chet));
+    EXPECT_EQ(196, search_end(vec, find_chet));
+
+    int* found = search_all(vec, find_chet);
+
+    EXPECT_EQ(1, found[0]);
+    EXPECT_EQ(97, found[48]);
+    EXPECT_EQ(100, found[49]);
+    EXPECT_EQ(196, found[97]);
+    EXPECT_EQ(-1, found[98]);
+
+    delete[] found;
+}
+
+TEST(TVectorTest, InsertIntoFullVectorWithDeletions) {
+    TVector<int> vec = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+        11, 12, 13, 14, 15 };
+    vec.pop_front();
+    vec.insert(vec.begin() + 5, 100);
+
+    TVector<int> expected = { 2, 3, 4, 5, 6, 100, 7, 8, 9, 10,
+        11, 12, 13, 14, 15 };
+    EXPECT_EQ(expected, vec);
+}
+
+TEST(TVectorTest, NonDefaultConstructibleElements) {
+    TVector<Tracked> vec;
+
+    for (int i = 0; i < 40; i++) {
+        vec.push_back(Tracked(i));
+    }
+
+    vec.push_front(Tracked(-1));
+    vec.insert(vec.begin() + 3, Tracked(100));
+    vec.emplace(vec.begin(), -2);
+    vec.erase(vec.begin() + 1);
+    vec.pop_back();
+    vec.reserve(200);
+
+    ASSERT_EQ(41, vec.size());
+    EXPECT_EQ(-2, vec[0].value);
+    EXPECT_EQ(0, vec[1].value);
+    EXPECT_EQ(1, vec[2].value);
+    EXPECT_EQ(100, vec[3].value);
+    EXPECT_EQ(38, vec[40].value);
+}
+
+TEST(TVectorTest, GrowthMovesElements) {
+    TVector<Tracked> vec;
+    Tracked::copies = 0;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(Tracked(i));
+    }
+
+    vec.push_front(Tracked(-1));
+    vec.insert(vec.begin() + 50, Tracked(-2));
+    vec.shrink_to_fit();
+
+    EXPECT_EQ(0, Tracked::copies);
+    EXPECT_EQ(-2, vec[50].value);
+    EXPECT_EQ(99, vec[101].value);
+}
+
+TEST(TVectorTest, ElementsDestroyed) {
+    Tracked::alive = 0;
+
+    {
+        TVector<Tracked> vec;
+
+        for (int i = 0; i < 50; i++) {
+            vec.push_back(Tracked(i));
+        }
+
+        for (int i = 0; i < 10; i++) {
+            vec.erase(vec.begin() + i);
+        }
+
+        TVector<Tracked> copy(vec);
+        copy.reserve(5);
+        vec = copy;
+        vec.clear();
+        EXPECT_EQ(5, Tracked::alive);
+    }
+
+    EXPECT_EQ(0, Tracked::alive);
+}
+
+TEST(TVectorTest, StringPairsSurviveGrowth) {
+    TVector<std::pair<std::string, std::string>> vec;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back({ std::to_string(i), std::string(32, 'a' + i % 26) });
+    }
+
+    vec.pop_front();
+    vec.insert(vec.begin(), { "first", "value" });
+
+    EXPECT_EQ("first", vec[0].first);
+    EXPECT_EQ("1", vec[1].first);
+    EXPECT_EQ(std::string(32, 'a' + 99 % 26), vec[99].second);
+}
+
+TEST(TVectorTest, PushBackOwnElementOnGrowth) {
+    TVector<std::string> vec;
+
+    for (int i = 0; i < 15; i++) {
+        vec.push_back(std::string(40, 'a' + i));
+    }
+
+    vec.push_back(vec[0]);
+    vec.insert(vec.begin(), vec[3]);
+
+    EXPECT_EQ(std::string(40, 'a'), vec[16]);
+    EXPECT_EQ(std::string(40, 'd'), vec[0]);
+}
+
 TEST(TVectorTest, MemoryManagementStress) {
     TVector<int> vec;
 
@@ -1150,6 +1422,127 @@ TEST(TVectorTest, IndexAccessWithDeletions) {
     EXPECT_EQ(7, vec[4]);
 }
 
+TEST(TVectorTest, IndexAccessWithDeletionsAcrossBlocks) {
+    TVector<int> vec;
+    vec.reserve(1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+
+    // Few tombstones, so no compaction happens
+    vec.erase(vec.begin() + 10);
+    vec.erase(vec.begin() + 500);
+    vec.erase(vec.begin() + 900);
+
+    EXPECT_EQ(997u, vec.size());
+    EXPECT_EQ(9, vec[9]);
+    EXPECT_EQ(11, vec[10]);
+    EXPECT_EQ(500, vec[499]);
+    EXPECT_EQ(502, vec[500]);
+    EXPECT_EQ(901, vec[899]);
+    EXPECT_EQ(903, vec[900]);
+    EXPECT_EQ(999, vec[996]);
+    EXPECT_THROW(vec[997], std::out_of_range);
+}
+
+TEST(TVectorTest, ConstIndexAccessWithDeletionsFromThreads) {
+    TVector<int> vec;
+    vec.reserve(1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+
+    vec.erase(vec.begin() + 10);
+    vec.erase(vec.begin() + 500);
+    vec.erase(vec.begin() + 900);
+
+    const TVector<int>& view = vec;
+    int mismatches[4] = { 0, 0, 0, 0 };
+    std::thread readers[4];
+
+    for (int t = 0; t < 4; t++) {
+        readers[t] = std::thread([&view, &mismatches, t]() {
+            for (size_t i = 0; i < view.size(); i++) {
+                int expected = static_cast<int>(i) + (i >= 10)
+                    + (i >= 500) + (i >= 900);
+
+                mismatches[t] += view[i] != expected;
+            }
+        });
+    }
+
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, mismatches[0] + mismatches[1] + mismatches[2]
+        + mismatches[3]);
+    EXPECT_EQ(11, vec[10]);
+    vec.erase(vec.begin() + 20);
+    EXPECT_EQ(22, view[20]);
+    EXPECT_EQ(999, view[995]);
+}
+
+TEST(TVectorTest, ConstIndexAccessAfterMutationsWithDeletions) {
+    TVector<int> vec;
+    TVector<int> tail({ 1000, 1001, 1002 });
+    vec.reserve(2000);
+
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+
+    vec.erase(vec.begin() + 100);
+    vec.erase(vec.begin() + 700);
+    vec.append(tail);
+    vec.append(TVector<int>({ 1003 }));
+    vec.insert(vec.begin() + 998, -1);
+
+    const TVector<int>& view = vec;
+
+    EXPECT_EQ(1003, view.size());
+    EXPECT_EQ(99, view[99]);
+    EXPECT_EQ(101, view[100]);
+    EXPECT_EQ(702, view[700]);
+    EXPECT_EQ(-1, view[998]);
+    EXPECT_EQ(1003, view[1002]);
+
+    vec.erase(vec.begin() + 10, vec.begin() + 20);
+
+    TVector<int> copy(vec);
+    const TVector<int>& copy_view = copy;
+
+    EXPECT_EQ(9, view[9]);
+    EXPECT_EQ(20, view[10]);
+    EXPECT_EQ(view[500], copy_view[500]);
+    EXPECT_EQ(1003, copy_view[992]);
+}
+
+TEST(TVectorTest, IndexAccessAfterDeletionsAndPushBack) {
+    TVector<int> vec;
+    vec.reserve(300);
+
+    for (int i = 0; i < 200; ++i) {
+        vec.push_back(i);
+    }
+
+    vec.pop_front();
+    EXPECT_EQ(1, vec[0]);
+    EXPECT_EQ(199, vec[198]);
+
+    vec.push_back(200);
+    vec.erase(vec.begin() + 100);
+    vec.push_back(201);
+
+    EXPECT_EQ(200u, vec.size());
+    EXPECT_EQ(100, vec[99]);
+    EXPECT_EQ(102, vec[100]);
+    EXPECT_EQ(200, vec[198]);
+    EXPECT_EQ(201, vec[199]);
+}
+
 TEST(TVectorTest, ConstOperations) {
     const TVector<int> vec = { 1, 2, 3, 4, 5 };
 
@@ -1243,6 +1636,76 @@ TEST(TVectorTest, CapacityManagement) {
     EXPECT_TRUE(capacity_increases);
 }
 
+TEST(TVectorTest, GrowthPolicyGeometricByDefault) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 61; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(Geometric, vec.growth_policy());
+    EXPECT_EQ(61u, vec.size());
+    EXPECT_EQ(120u, vec.capacity());
+    EXPECT_EQ(60, vec[60]);
+}
+
+TEST(TVectorTest, GrowthPolicyFixedStep) {
+    TVector<int> vec;
+    vec.set_growth_policy(FixedStep);
+
+    for (int i = 0; i < 61; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(FixedStep, vec.growth_policy());
+    EXPECT_EQ(61u, vec.size());
+    EXPECT_EQ(75u, vec.capacity());
+    EXPECT_EQ(60, vec[60]);
+}
+
+TEST(TVectorTest, GrowthPolicyCopied) {
+    TVector<int> vec_1 = { 1, 2, 3 };
+    vec_1.set_growth_policy(FixedStep);
+    TVector<int> vec_2(vec_1);
+
+    EXPECT_EQ(FixedStep, vec_2.growth_policy());
+}
+
+TEST(TVectorTest, PoliciesFollowEveryCopyAndMove) {
+    TVector<int> source = { 1, 2, 3 };
+    source.set_growth_policy(FixedStep);
+    source.set_compaction_policy(Incremental);
+    source.set_removal_coefficient(0.5f);
+    source.set_compaction_step(4);
+
+    TVector<int> copied;
+    TVector<int> moved;
+    copied = source;
+    TVector<int> copy = source;
+    moved = std::move(copy);
+    TVector<int> constructed(std::move(moved));
+
+    for (const TVector<int>* vec : { &copied, &constructed }) {
+        EXPECT_EQ(FixedStep, vec->growth_policy());
+        EXPECT_EQ(Incremental, vec->compaction_policy());
+        EXPECT_FLOAT_EQ(0.5f, vec->removal_coefficient());
+        EXPECT_EQ(4, vec->compaction_step());
+    }
+}
+
+TEST(TVectorTest, AppendKeepsPolicies) {
+    TVector<int> vec;
+    TVector<int> other = { 1, 2, 3 };
+    other.set_growth_policy(FixedStep);
+    other.set_compaction_policy(Incremental);
+
+    vec.append(std::move(other));
+
+    EXPECT_EQ(3, vec.size());
+    EXPECT_EQ(Geometric, vec.growth_policy());
+    EXPECT_EQ(Threshold, vec.compaction_policy());
+}
+
 TEST(TVectorTest, EqualityAfterOperations) {
     TVector<int> vec1 = { 1, 2, 3, 4, 5 };
     TVector<int> vec2 = { 0, 1, 2, 3, 4, 5, 6 };
@@ -1305,18 +1768,859 @@ TEST(TVectorTest, SortWithDeletions) {
     EXPECT_TRUE(is_sorted);
 }
 
-TEST(TVectorTest, ShufflePreservesElements) {
-    TVector<int> vec = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
-    TVector<int> original = vec;
+TEST(TVectorTest, SortWithLambda) {
+    TVector<int> vec = { 3, 1, 4, 1, 5, 9, 2, 6 };
+    TVector<int> expected = { 9, 6, 5, 4, 3, 2, 1, 1 };
 
-    shuffle(vec);
+    tv_sort(vec, [](int a, int b) { return a > b; });
+
+    EXPECT_EQ(expected, vec);
+}
+
+TEST(TVectorTest, SortDefaultComparator) {
+    TVector<std::string> vec = { "pear", "apple", "fig" };
+    TVector<std::string> expected = { "apple", "fig", "pear" };
+
+    tv_sort(vec);
+
+    EXPECT_EQ(expected, vec);
+}
+
+TEST(TVectorTest, SortLargeWithDuplicates) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 10000; i++) {
+        vec.push_back((i * 7919) % 13);
+    }
+
+    tv_sort(vec);
+
+    EXPECT_EQ(10000, vec.size());
+    EXPECT_EQ(0, vec[0]);
+    EXPECT_EQ(12, vec[9999]);
+
+    for (size_t i = 1; i < vec.size(); i++) {
+        ASSERT_LE(vec[i - 1], vec[i]);
+    }
+}
+
+TEST(TVectorTest, SortOrganPipe) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 50000; i++) {
+        vec.push_back(i < 25000 ? i : 50000 - i);
+    }
 
-    // Sort both vectors to compare content
     tv_sort(vec, sort_ascending);
-    tv_sort(original, sort_ascending);
 
-    EXPECT_EQ(original, vec);
-    EXPECT_EQ(original.size(), vec.size());
+    for (size_t i = 1; i < vec.size(); i++) {
+        ASSERT_LE(vec[i - 1], vec[i]);
+    }
+}
+
+TEST(TVectorTest, SortPacksDeletions) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(100 - i);
+    }
+
+    for (int i = 0; i < 10; i++) {
+        vec.erase(vec.begin() + i * 5);
+    }
+
+    tv_sort(vec);
+
+    ASSERT_EQ(90, vec.size());
+
+    for (size_t i = 1; i < vec.size(); i++) {
+        EXPECT_LT(vec.data()[i - 1], vec.data()[i]);
+    }
+}
+
+TEST(TVectorTest, StableSortKeepsOrderOfEqual) {
+    TVector<std::pair<int, int>> vec;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back({ i % 3, i });
+    }
+
+    tv_stable_sort(vec, [](const std::pair<int, int>& a,
+        const std::pair<int, int>& b) { return a.first < b.first; });
+
+    for (size_t i = 1; i < vec.size(); i++) {
+        if (vec[i - 1].first == vec[i].first) {
+            EXPECT_LT(vec[i - 1].second, vec[i].second);
+        } else {
+            EXPECT_LT(vec[i - 1].first, vec[i].first);
+        }
+    }
+}
+
+TEST(TVectorTest, PartialSort) {
+    TVector<int> vec = { 9, 3, 7, 1, 8, 2, 6, 4, 5, 0 };
+
+    tv_partial_sort(vec, 4);
+
+    EXPECT_EQ(10, vec.size());
+    EXPECT_EQ(0, vec[0]);
+    EXPECT_EQ(1, vec[1]);
+    EXPECT_EQ(2, vec[2]);
+    EXPECT_EQ(3, vec[3]);
+}
+
+TEST(TVectorTest, PartialSortWholeVector) {
+    TVector<int> vec = { 5, 4, 3, 2, 1 };
+    TVector<int> expected = { 1, 2, 3, 4, 5 };
+
+    tv_partial_sort(vec, 100, sort_ascending);
+
+    EXPECT_EQ(expected, vec);
+}
+
+TEST(TVectorTest, ParallelSortMatchesSort) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 200000; i++) {
+        vec.push_back((i * 7919) % 100003 - 50000);
+    }
+
+    TVector<int> expected = vec;
+    tv_sort(expected);
+
+    for (size_t threads = 2; threads <= 7; threads++) {
+        TVector<int> copy = vec;
+
+        tv_parallel_sort(copy, sort_ascending, threads);
+
+        ASSERT_EQ(expected, copy);
+    }
+}
+
+TEST(TVectorTest, ParallelSortStrings) {
+    TVector<std::string> vec;
+
+    for (int i = 0; i < 70000; i++) {
+        vec.push_back(std::to_string((i * 31337) % 70001));
+    }
+
+    tv_parallel_sort(vec, [](const std::string& a, const std::string& b) {
+        return a < b; }, 3);
+
+    EXPECT_EQ(70000, vec.size());
+
+    for (size_t i = 1; i < vec.size(); i++) {
+        ASSERT_LE(vec[i - 1], vec[i]);
+    }
+}
+
+TEST(TVectorTest, ParallelSortPacksDeletions) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 100000; i++) {
+        vec.push_back(100000 - i);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        vec.erase(vec.begin() + i * 10);
+    }
+
+    tv_parallel_sort(vec, sort_ascending, 4);
+
+    EXPECT_EQ(99900, vec.size());
+
+    for (size_t i = 1; i < vec.size(); i++) {
+        ASSERT_LT(vec[i - 1], vec[i]);
+    }
+}
+
+TEST(TVectorTest, ParallelSortSmallVector) {
+    TVector<int> vec = { 5, 1, 4, 2, 3 };
+    TVector<int> expected = { 1, 2, 3, 4, 5 };
+
+    tv_parallel_sort(vec);
+
+    EXPECT_EQ(expected, vec);
+}
+
+TEST(TVectorTest, RadixSortSignedInts) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 5000; i++) {
+        vec.push_back((i * 7919) % 10007 - 5003);
+    }
+
+    vec.push_back(INT32_MIN);
+    vec.push_back(INT32_MAX);
+
+    TVector<int> expected = vec;
+    tv_sort(expected);
+
+    tv_radix_sort(vec);
+
+    EXPECT_EQ(expected, vec);
+}
+
+TEST(TVectorTest, RadixSortUnsignedAndShortVectors) {
+    TVector<unsigned> vec;
+    TVector<unsigned> short_vec = { 30, 10, 20 };
+    TVector<unsigned> short_expected = { 10, 20, 30 };
+
+    for (unsigned i = 0; i < 3000; i++) {
+        vec.push_back(i * 2654435761u);
+    }
+
+    TVector<unsigned> expected = vec;
+    tv_sort(expected);
+
+    tv_radix_sort(vec);
+    tv_radix_sort(short_vec);
+
+    EXPECT_EQ(expected, vec);
+    EXPECT_EQ(short_expected, short_vec);
+}
+
+TEST(TVectorTest, RadixSortFloats) {
+    TVector<float> vec;
+
+    for (int i = 0; i < 2000; i++) {
+        vec.push_back(static_cast<float>((i * 7919) % 2003 - 1000) / 7.0f);
+    }
+
+    vec.push_back(-0.0f);
+    vec.push_back(1e30f);
+    vec.push_back(-1e30f);
+
+    tv_radix_sort(vec);
+
+    EXPECT_EQ(2003, vec.size());
+    EXPECT_NEAR(-1e30f, vec[0], 1e24f);
+    EXPECT_NEAR(1e30f, vec[2002], 1e24f);
+
+    for (size_t i = 1; i < vec.size(); i++) {
+        ASSERT_LE(vec[i - 1], vec[i]);
+    }
+}
+
+TEST(TVectorTest, RadixSortPairsByKeyIsStable) {
+    TVector<std::pair<int, std::string>> vec;
+
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back({ (i * 37) % 10 - 5, std::to_string(i) });
+    }
+
+    tv_radix_sort(vec, [](const std::pair<int, std::string>& elem) {
+        return elem.first; });
+
+    EXPECT_EQ(1000, vec.size());
+
+    for (size_t i = 1; i < vec.size(); i++) {
+        if (vec[i - 1].first == vec[i].first) {
+            ASSERT_LT(std::stoi(vec[i - 1].second), std::stoi(vec[i].second));
+        } else {
+            ASSERT_LT(vec[i - 1].first, vec[i].first);
+        }
+    }
+}
+
+TEST(TVectorTest, RadixSortPacksDeletions) {
+    TVector<int64_t> vec;
+
+    for (int64_t i = 0; i < 1000; i++) {
+        vec.push_back((i % 2 ? -1 : 1) * i * 1000000007LL);
+    }
+
+    for (int i = 0; i < 50; i++) {
+        vec.erase(vec.begin() + i);
+    }
+
+    TVector<int64_t> expected = vec;
+    tv_sort(expected);
+
+    tv_radix_sort(vec);
+
+    EXPECT_EQ(950, vec.size());
+    EXPECT_EQ(expected, vec);
+}
+
+TEST(TVectorTest, RadixSortInPlace) {
+    TVector<int> ints;
+    TVector<double> doubles;
+
+    for (int i = 0; i < 20000; i++) {
+        ints.push_back((i * 7919) % 20011 - 10000);
+        doubles.push_back(((i * 31) % 1009 - 504) * 0.25);
+    }
+
+    TVector<int> expected_ints = ints;
+    TVector<double> expected_doubles = doubles;
+    tv_sort(expected_ints);
+    tv_sort(expected_doubles);
+
+    tv_radix_sort_in_place(ints);
+    tv_radix_sort_in_place(doubles);
+
+    EXPECT_EQ(expected_ints, ints);
+    EXPECT_EQ(expected_doubles, doubles);
+}
+
+TEST(TVectorTest, RadixSortInPlaceByKey) {
+    TVector<std::pair<uint16_t, int>> vec;
+
+    for (int i = 0; i < 3000; i++) {
+        vec.push_back({ static_cast<uint16_t>((i * 7919) % 65521), i });
+    }
+
+    tv_radix_sort_in_place(vec, [](const std::pair<uint16_t, int>& elem) {
+        return elem.first; });
+
+    for (size_t i = 1; i < vec.size(); i++) {
+        ASSERT_LE(vec[i - 1].first, vec[i].first);
+    }
+}
+
+TEST(TVectorTest, FindIfWithLambda) {
+    TVector<std::string> vec = { "a", "bb", "ccc", "bb", "d" };
+    size_t length = 2;
+
+    EXPECT_EQ(1, find_if(vec, [length](const std::string& elem) {
+        return elem.size() == length; }));
+    EXPECT_EQ(3, find_last_if(vec, [length](const std::string& elem) {
+        return elem.size() == length; }));
+    EXPECT_EQ(TVector<std::string>::npos, find_if(vec,
+        [](const std::string& elem) { return elem.empty(); }));
+    EXPECT_EQ(TVector<std::string>::npos, find_last_if(vec,
+        [](const std::string& elem) { return elem.empty(); }));
+}
+
+TEST(TVectorTest, FindOnEmptyVector) {
+    TVector<int> vec;
+    size_t out[1];
+
+    EXPECT_EQ(TVector<int>::npos, find_if(vec, tv_equal(1)));
+    EXPECT_EQ(TVector<int>::npos, find_last_if(vec, tv_equal(1)));
+    EXPECT_EQ(0, find_all(vec, tv_equal(1), out, 1));
+
+    for (size_t index : find_all(vec, tv_equal(1))) {
+        ADD_FAILURE() << index;
+    }
+}
+
+TEST(TVectorTest, FindSkipsDeletedElements) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 300; i++) {
+        vec.push_back(i % 10);
+    }
+
+    for (int i = 0; i < 30; i++) {
+        vec.erase(vec.begin() + i * 9);
+    }
+
+    for (size_t i = 0; i < vec.size(); i++) {
+        if (vec[i] == 7) {
+            EXPECT_EQ(i, find_if(vec, tv_equal(7)));
+            break;
+        }
+    }
+
+    for (size_t i = vec.size(); i > 0; i--) {
+        if (vec[i - 1] == 7) {
+            EXPECT_EQ(i - 1, find_last_if(vec, tv_equal(7)));
+            break;
+        }
+    }
+}
+
+TEST(TVectorTest, FindAllIntoBuffer) {
+    TVector<int> vec = { 5, 1, 5, 2, 5, 3 };
+    size_t out[2];
+
+    EXPECT_EQ(2, find_all(vec, tv_equal(5), out, 2));
+    EXPECT_EQ(0, out[0]);
+    EXPECT_EQ(2, out[1]);
+}
+
+TEST(TVectorTest, FindAllLazyMatchesScan) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 1000; i++) {
+        vec.push_back((i * 7919) % 101);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        vec.erase(vec.begin() + i * 3);
+    }
+
+    size_t expected = 0;
+    size_t visited = 0;
+
+    for (size_t index : find_all(vec, tv_between(10, 20))) {
+        while (vec[expected] < 10 || vec[expected] > 20) {
+            expected++;
+        }
+
+        ASSERT_EQ(expected, index);
+        expected++;
+        visited++;
+    }
+
+    size_t matches = 0;
+
+    for (size_t i = 0; i < vec.size(); i++) {
+        matches += vec[i] >= 10 && vec[i] <= 20;
+    }
+
+    EXPECT_EQ(matches, visited);
+}
+
+TEST(TVectorTest, FindArithmeticPredicates) {
+    TVector<float> floats;
+    TVector<double> doubles;
+
+    for (int i = 0; i < 200; i++) {
+        floats.push_back(i * 0.5f);
+        doubles.push_back(i * 0.5);
+    }
+
+    floats.erase(floats.begin());
+
+    EXPECT_EQ(20, find_if(floats, tv_equal(10.5f)));
+    EXPECT_EQ(21, find_if(doubles, tv_equal(10.5)));
+    EXPECT_EQ(20, find_if(doubles, tv_equal(10)));
+    EXPECT_EQ(TVector<double>::npos, find_if(doubles, tv_equal(100)));
+    EXPECT_EQ(TVector<float>::npos, find_if(floats, tv_equal(0.0f)));
+    EXPECT_EQ(3, find_if(floats, tv_between(1.6f, 3.0f)));
+    EXPECT_EQ(5, find_last_if(floats, tv_between(1.6f, 3.0f)));
+}
+
+TEST(TVectorTest, PushFrontManyKeepsOrder) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 10000; i++) {
+        vec.push_front(i);
+    }
+
+    ASSERT_EQ(10000, vec.size());
+    EXPECT_EQ(9999, vec.front());
+    EXPECT_EQ(0, vec.back());
+    EXPECT_EQ(&vec.front(), vec.data());
+
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_EQ(9999 - i, vec[i]);
+    }
+}
+
+TEST(TVectorTest, PushFrontAndBackMixed) {
+    TVector<std::string> vec;
+
+    for (int i = 0; i < 500; i++) {
+        vec.push_front(std::to_string(-i - 1));
+        vec.push_back(std::to_string(i));
+    }
+
+    ASSERT_EQ(1000, vec.size());
+
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(std::to_string(i - 500), vec[i]);
+    }
+}
+
+TEST(TVectorTest, InsertNearFrontUsesFrontRoom) {
+    TVector<std::string> vec;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_front(std::to_string(i));
+    }
+
+    vec.insert(vec.begin() + 2, "a");
+    vec.insert(vec.begin() + 1, 2, "b");
+    vec.insert(vec.begin() + 90, "c");
+    vec.emplace(vec.begin(), "d");
+
+    TVector<std::string> expected;
+
+    for (int i = 0; i < 100; i++) {
+        expected.push_back(std::to_string(99 - i));
+    }
+
+    expected.insert(expected.begin() + 2, "a");
+    expected.insert(expected.begin() + 1, 2, "b");
+    expected.insert(expected.begin() + 90, "c");
+    expected.emplace(expected.begin(), "d");
+
+    EXPECT_EQ(expected, vec);
+}
+
+TEST(TVectorTest, FrontRoomWithDeletions) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 200; i++) {
+        vec.push_front(i);
+    }
+
+    vec.erase(vec.begin() + 5);
+    vec.pop_front();
+    vec.push_front(1000);
+    vec.pop_back();
+
+    EXPECT_EQ(198, vec.size());
+    EXPECT_EQ(1000, vec[0]);
+    EXPECT_EQ(198, vec[1]);
+    EXPECT_EQ(193, vec[5]);
+    EXPECT_EQ(1, vec[197]);
+    EXPECT_EQ(5, find_if(vec, tv_equal(193)));
+    EXPECT_EQ(197, find_last_if(vec, tv_equal(1)));
+
+    tv_sort(vec);
+
+    EXPECT_EQ(1, vec[0]);
+    EXPECT_EQ(1000, vec[197]);
+}
+
+TEST(TVectorTest, CopyAndMoveWithFrontRoom) {
+    TVector<std::string> vec;
+
+    for (int i = 0; i < 50; i++) {
+        vec.push_front(std::to_string(i));
+    }
+
+    TVector<std::string> copy(vec);
+    TVector<std::string> assigned;
+    assigned = vec;
+    TVector<std::string> moved(std::move(copy));
+
+    EXPECT_EQ(vec, assigned);
+    EXPECT_EQ(vec, moved);
+    EXPECT_EQ(0, copy.size());
+
+    moved.shrink_to_fit();
+
+    EXPECT_EQ(50, moved.capacity());
+    EXPECT_EQ("49", moved[0]);
+
+    moved.clear();
+    moved.push_front("x");
+
+    EXPECT_EQ(1, moved.size());
+    EXPECT_EQ("x", moved.front());
+}
+
+TEST(TVectorTest, EraseReturnsNextElement) {
+    TVector<int> vec;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(i);
+    }
+
+    for (auto it = vec.begin(); it != vec.end();) {
+        if (*it % 3 == 0)
+            it = vec.erase(it);
+        else
+            ++it;
+    }
+
+    ASSERT_EQ(66, vec.size());
+
+    for (size_t i = 0; i < vec.size(); i++) {
+        EXPECT_NE(0, vec[i] % 3);
+    }
+
+    EXPECT_EQ(vec.end(), vec.erase(vec.begin() + 65));
+}
+
+TEST(TVectorTest, EraseRange) {
+    TVector<int> vec = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    TVector<int> expected = { 0, 1, 6, 7, 8, 9 };
+
+    auto it = vec.erase(vec.begin() + 2, vec.begin() + 6);
+
+    EXPECT_EQ(6, *it);
+    EXPECT_EQ(expected, vec);
+    EXPECT_EQ(vec.end(), vec.erase(vec.begin() + 4, vec.end()));
+    EXPECT_EQ(4, vec.size());
+    EXPECT_EQ(vec.begin(), vec.erase(vec.begin(), vec.begin()));
+    EXPECT_THROW(vec.erase(vec.end(), vec.begin()), std::invalid_argument);
+}
+
+TEST(TVectorTest, EraseRangeWithDeletedAround) {
+    TVector<std::string> vec;
+    TVector<std::string> expected;
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(std::to_string(i));
+    }
+
+    vec.erase(vec.begin() + 10);
+    vec.erase(vec.begin() + 80);
+
+    for (int i = 0; i < 100; i++) {
+        if (i != 10 && i != 81 && (i < 30 || i >= 60))
+            expected.push_back(std::to_string(i));
+    }
+
+    auto it = vec.erase(vec.begin() + 29, vec.begin() + 59);
+
+    EXPECT_EQ("60", *it);
+    EXPECT_EQ(expected, vec);
+    EXPECT_EQ("82", vec[50]);
+    EXPECT_EQ(expected.size(), vec.end() - vec.begin());
+}
+
+TEST(TVectorTest, EraseIfAndRetain) {
+    TVector<std::string> vec;
+
+    for (int i = 0; i < 50; i++) {
+        vec.push_back(std::to_string(i));
+    }
+
+    vec.erase(vec.begin());
+
+    EXPECT_EQ(5, vec.erase_if([](const std::string& elem) {
+        return elem.back() == '7'; }));
+    EXPECT_EQ(44, vec.size());
+    EXPECT_EQ(TVector<std::string>::npos, find_if(vec,
+        [](const std::string& elem) { return elem == "17"; }));
+
+    EXPECT_EQ(36, vec.retain([](const std::string& elem) {
+        return elem.size() == 1; }));
+
+    TVector<std::string> expected = { "1", "2", "3", "4", "5", "6", "8", "9" };
+    EXPECT_EQ(expected, vec);
+    EXPECT_EQ(0, vec.erase_if([](const std::string&) { return false; }));
+}
+
+TEST(TVectorTest, CompactionPolicySettings) {
+    TVector<int> vec;
+
+    EXPECT_EQ(Threshold, vec.compaction_policy());
+    EXPECT_NEAR(0.15f, vec.removal_coefficient(), EPSILON);
+
+    vec.set_compaction_policy(Incremental);
+    vec.set_removal_coefficient(0.5f);
+    vec.set_compaction_step(4);
+
+    TVector<int> copy(vec);
+
+    EXPECT_EQ(Incremental, copy.compaction_policy());
+    EXPECT_NEAR(0.5f, copy.removal_coefficient(), EPSILON);
+    EXPECT_EQ(4, copy.compaction_step());
+    EXPECT_THROW(vec.set_removal_coefficient(0.0f), std::invalid_argument);
+    EXPECT_THROW(vec.set_removal_coefficient(1.5f), std::invalid_argument);
+    EXPECT_THROW(vec.set_compaction_step(0), std::invalid_argument);
+}
+
+TEST(TVectorTest, ManualCompactionKeepsCapacity) {
+    TVector<std::string> vec;
+    vec.set_compaction_policy(Manual);
+
+    for (int i = 0; i < 100; i++) {
+        vec.push_back(std::to_string(i));
+    }
+
+    size_t capacity = vec.capacity();
+
+    for (int i = 0; i < 60; i++) {
+        vec.erase(vec.begin() + i % vec.size());
+    }
+
+    vec.pop_front();
+    vec.pop_back();
+    EXPECT_EQ(38, vec.size());
+    EXPECT_EQ(capacity, vec.capacity());
+
+    TVector<std::string> before(vec);
+    vec.compact();
+
+    EXPECT_EQ(before, vec);
+    EXPECT_EQ(capacity, vec.capacity());
+    vec.push_back("last");
+    EXPECT_EQ("last", vec[38]);
+}
+
+TEST(TVectorTest, IncrementalCompactionKeepsOrder) {
+    TVector<std::string> vec;
+    TVector<std::string> expected;
+    vec.set_compaction_policy(Incremental);
+    vec.set_compaction_step(2);
+
+    for (int i = 0; i < 200; i++) {
+        vec.push_back(std::to_string(i));
+
+        if (i % 3 != 0)
+            expected.push_back(std::to_string(i));
+    }
+
+    size_t capacity = vec.capacity();
+    auto it = vec.begin();
+
+    for (int i = 0; i < 200; i++) {
+        if (i % 3 == 0) {
+            it = vec.erase(it);
+            ASSERT_TRUE(it == vec.end() || *it == std::to_string(i + 1));
+        } else {
+            ++it;
+        }
+    }
+
+    EXPECT_EQ(expected, vec);
+    EXPECT_EQ(capacity, vec.capacity());
+
+    for (int i = 0; i < 20; i++) {
+        vec.pop_front();
+        expected.pop_front();
+    }
+
+    EXPECT_EQ(expected, vec);
+    EXPECT_EQ(expected[50], vec[50]);
+}
+
+TEST(TVectorTest, AppendRanges) {
+    TVector<int> vec = { 1, 2 };
+    TVector<int> other = { 3, 4, 5, 6 };
+    int array[] = { 7, 8 };
+    std::istringstream stream("9 10");
+
+    other.erase(other.begin() + 1);
+    vec.append(other);
+    vec.append(array, array + 2);
+    vec.append(std::istream_iterator<int>(stream),
+        std::istream_iterator<int>());
+    vec.append(vec);
+
+    TVector<int> expected = { 1, 2, 3, 5, 6, 7, 8, 9, 10,
+        1, 2, 3, 5, 6, 7, 8, 9, 10 };
+    EXPECT_EQ(expected, vec);
+    EXPECT_EQ(3, other.size());
+}
+
+TEST(TVectorTest, AppendMovesElements) {
+    TVector<std::string> vec = { "a" };
+    TVector<std::string> other = { "b", "c", "d" };
+    TVector<std::string> empty;
+
+    other.pop_front();
+    vec.append(std::move(other));
+    empty.append(std::move(vec));
+
+    TVector<std::string> expected = { "a", "c", "d" };
+    EXPECT_EQ(expected, empty);
+    EXPECT_EQ(0, other.size());
+    EXPECT_EQ(0, vec.size());
+
+    other.push_back("e");
+    EXPECT_EQ("e", other.front());
+}
+
+TEST(TVectorTest, InsertRange) {
+    TVector<std::string> vec = { "a", "e" };
+    std::string middle[] = { "b", "c", "d" };
+
+    auto it = vec.insert(vec.begin() + 1, middle, middle + 3);
+    EXPECT_EQ("b", *it);
+
+    vec.push_front("0");
+    vec.pop_front();
+    vec.insert(vec.begin(), std::make_move_iterator(middle),
+        std::make_move_iterator(middle + 1));
+    vec.insert(vec.end(), middle + 1, middle + 1);
+
+    TVector<std::string> expected = { "b", "a", "b", "c", "d", "e" };
+    EXPECT_EQ(expected, vec);
+    EXPECT_EQ("", middle[0]);
+
+    TVector<int> counts = { 1, 2 };
+    counts.insert(counts.begin() + 1, 3, 7);
+    EXPECT_EQ(TVector<int>({ 1, 7, 7, 7, 2 }), counts);
+}
+
+TEST(TVectorTest, EmplaceConstructsInPlace) {
+    TVector<Tracked> vec;
+
+    vec.emplace_back(1);
+    vec.emplace_front(0);
+    Tracked::copies = 0;
+    Tracked::moves = 0;
+
+    Tracked& back = vec.emplace_back(2);
+    Tracked& front = vec.emplace_front(-1);
+    vec.emplace(vec.begin() + 4, 3);
+
+    EXPECT_EQ(0, Tracked::copies);
+    EXPECT_EQ(0, Tracked::moves);
+    EXPECT_EQ(2, back.value);
+    EXPECT_EQ(-1, front.value);
+    EXPECT_EQ(5, vec.size());
+
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(i - 1, vec[i].value);
+    }
+}
+
+TEST(TVectorTest, EmplaceReusesDeletedSlots) {
+    TVector<std::pair<int, std::string>> vec;
+
+    for (int i = 0; i < 20; i++) {
+        vec.emplace_back(i, std::to_string(i));
+    }
+
+    vec.set_compaction_policy(Manual);
+    vec.pop_back();
+    vec.pop_front();
+
+    EXPECT_EQ("x", vec.emplace_back(20, "x").second);
+    EXPECT_EQ("y", vec.emplace_front(-1, "y").second);
+    EXPECT_EQ(20, vec.size());
+    EXPECT_EQ(-1, vec.front().first);
+    EXPECT_EQ(20, vec.back().first);
+
+    // The argument refers to an element that moves when the vector grows.
+    TVector<std::string> words = { "a" };
+
+    for (int i = 0; i < 40; i++) {
+        words.emplace_back(words[0]);
+        words.emplace_front(words[words.size() - 1]);
+    }
+
+    EXPECT_EQ(81, words.size());
+    EXPECT_EQ("a", words[40]);
+    EXPECT_EQ("a", words.front());
+}
+
+TEST(TVectorTest, ShufflePreservesElements) {
+    TVector<int> vec = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    TVector<int> original = vec;
+
+    shuffle(vec);
+
+    // Sort both vectors to compare content
+    tv_sort(vec, sort_ascending);
+    tv_sort(original, sort_ascending);
+
+    EXPECT_EQ(original, vec);
+    EXPECT_EQ(original.size(), vec.size());
+}
+
+TEST(TVectorTest, ShuffleAfterPushFront) {
+    TVector<std::string> words;
+    TVector<std::string> empty;
+
+    for (int i = 0; i < 40; i++) {
+        words.push_front(std::to_string(i));
+    }
+
+    shuffle(words);
+    shuffle(empty);
+    tv_sort(words, [](const std::string& a, const std::string& b) {
+        return std::stoi(a) < std::stoi(b);
+    });
+
+    EXPECT_EQ(40, words.size());
+    EXPECT_EQ(0, empty.size());
+
+    for (int i = 0; i < 40; i++) {
+        EXPECT_EQ(std::to_string(i), words[i]);
+    }
 }
 
 TEST(TVectorTest, PerformancePushBack) {